@@ -0,0 +1,43 @@
+#ifndef _Adapter_Traits
+#define _Adapter_Traits
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+// What the container underneath Stack, Queue or Priority_queue offers beyond push_back/pop_back, so their
+// batch operations (push_range, pop_n) can use the container's bulk members when it has them
+namespace adapter_detail {
+
+	// c.insert(c.end(), first, last) compiles for iterators of type It
+	template <typename C, typename It, typename = void>
+	struct has_range_insert : std::false_type {};
+
+	template <typename C, typename It>
+	struct has_range_insert<C, It, std::void_t<decltype(std::declval<C&>().insert(std::declval<C&>().end(), std::declval<It>(), std::declval<It>()))>>
+		: std::true_type {};
+
+	// c.erase(first, last) compiles and the iterators are random access, so a batch at either end is located in O(1)
+	template <typename C, typename = void>
+	struct has_range_erase : std::false_type {};
+
+	template <typename C>
+	struct has_range_erase<C, std::void_t<decltype(std::declval<C&>().erase(std::declval<C&>().begin(), std::declval<C&>().end()))>>
+		: std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<typename C::iterator>::iterator_category> {};
+
+	// The elements are one array starting at c.data()
+	template <typename C, typename = void>
+	struct is_contiguous : std::false_type {};
+
+	template <typename C>
+	struct is_contiguous<C, std::void_t<decltype(std::declval<C&>().data())>> : has_range_erase<C> {};
+
+	// Elements can be copied between C and OutputIt with memcpy: both sides are arrays of trivially copyable values
+	template <typename C, typename OutputIt>
+	inline constexpr bool raw_copy = is_contiguous<C>::value && std::is_trivially_copyable_v<typename C::value_type> &&
+		std::is_same_v<OutputIt, typename C::value_type*>;
+}
+
+
+#endif // !_Adapter_Traits
@@ -0,0 +1,84 @@
+#ifndef _Counting_Allocator
+#define _Counting_Allocator
+
+#define ND [[nodiscard]]
+
+#include "../Instrumentation/Container_stats.h"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+
+// Allocator wrapper recording every allocation a container makes: calls, live and peak objects, bytes.
+// Copies and rebinds share one set of counters, so a Forward_list<T, Counting_allocator<T>> counts its nodes
+// and stats() (see Instrumentation/Container_stats.h) reports them. Works with any upstream allocator;
+// release() is passed through so pooling allocators still get their slabs back. Not thread-safe, like the
+// containers it instruments.
+template <typename T, typename Upstream = std::allocator<T>>
+class Counting_allocator {
+	using traits = std::allocator_traits<Upstream>;
+
+public:
+	using value_type	= T;
+	using pointer		= typename traits::pointer;
+	using size_type		= typename traits::size_type;
+
+	using propagate_on_container_copy_assignment	= std::true_type;
+	using propagate_on_container_move_assignment	= std::true_type;
+	using propagate_on_container_swap				= std::true_type;
+	using is_always_equal							= std::false_type;
+
+	template <typename U>
+	struct rebind {
+		using other = Counting_allocator<U, typename traits::template rebind_alloc<U>>;
+	};
+
+
+	Counting_allocator() : counts(std::make_shared<Allocation_counters>()) {}
+
+	explicit Counting_allocator(const Upstream& upstream) : up(upstream), counts(std::make_shared<Allocation_counters>()) {}
+
+	template <typename U, typename Other_upstream>
+	Counting_allocator(const Counting_allocator<U, Other_upstream>& other) noexcept : up(other.up), counts(other.counts) {}
+
+	ND pointer allocate(size_type n) {
+		pointer p = traits::allocate(up, n);
+		counts->on_allocate(n, n * sizeof(T));
+		return p;
+	}
+
+	void deallocate(pointer p, size_type n) noexcept {
+		counts->on_deallocate(n, n * sizeof(T));
+		traits::deallocate(up, p, n);
+	}
+
+	template <typename A = Upstream>
+	auto release() noexcept(noexcept(std::declval<A&>().release())) -> decltype(std::declval<A&>().release()) {
+		return up.release();
+	}
+
+	ND const Allocation_counters& counters() const noexcept { return *counts; }
+
+	ND const Upstream& upstream() const noexcept { return up; }
+
+	template <typename U, typename Other_upstream>
+	bool operator==(const Counting_allocator<U, Other_upstream>& other) const noexcept {
+		return counts == other.counts && up == other.up;
+	}
+
+	template <typename U, typename Other_upstream>
+	bool operator!=(const Counting_allocator<U, Other_upstream>& other) const noexcept {
+		return !(*this == other);
+	}
+
+private:
+	template <typename U, typename Other_upstream>
+	friend class Counting_allocator;
+
+	Upstream up;
+	std::shared_ptr<Allocation_counters> counts;
+};
+
+
+#endif // !_Counting_Allocator
@@ -0,0 +1,119 @@
+#ifndef _Monotonic_Arena
+#define _Monotonic_Arena
+
+#define ND [[nodiscard]]
+
+#include <memory_resource>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+
+// Bump-pointer memory resource. Allocation moves a cursor forward, deallocation does nothing and
+// release() hands every chunk back to the upstream resource at once. Meant for data whose lifetime ends
+// together, e.g. everything built while serving one request:
+//
+//     Monotonic_arena arena;
+//     pmr::Forward_list<int> list(&arena);
+//     ...
+//     arena.release();	// after list is gone
+//
+// An optional caller-provided buffer is used first, chunks then grow geometrically. Not thread-safe.
+class Monotonic_arena : public std::pmr::memory_resource {
+public:
+	static constexpr size_t first_chunk_size = 1024;
+	static constexpr size_t max_chunk_size = size_t(1) << 24;
+
+	explicit Monotonic_arena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+		: upstream(upstream) {}
+
+	explicit Monotonic_arena(size_t initial_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+		: upstream(upstream), next_size(initial_size < alignof(std::max_align_t) ? alignof(std::max_align_t) : initial_size) {}
+
+	Monotonic_arena(void* buffer, size_t size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+		: upstream(upstream), initial_buffer(static_cast<char*>(buffer)), initial_size(size),
+		  cursor(static_cast<char*>(buffer)), last(static_cast<char*>(buffer) + size),
+		  next_size(size < first_chunk_size ? first_chunk_size : size * 2) {}
+
+	Monotonic_arena(const Monotonic_arena&) = delete;
+	Monotonic_arena& operator=(const Monotonic_arena&) = delete;
+
+	~Monotonic_arena() override { release(); }
+
+	// Frees every chunk taken from upstream and rewinds to the initial buffer.
+	// Everything allocated from the arena is gone afterwards, destructors are not run.
+	void release() noexcept {
+		while (chunks) {
+			Chunk* next = chunks->next;
+			upstream->deallocate(chunks, chunks->bytes, alignof(Chunk));
+			chunks = next;
+		}
+
+		cursor = initial_buffer;
+		last = initial_buffer + initial_size;
+		used = 0;
+	}
+
+	ND std::pmr::memory_resource* upstream_resource() const noexcept { return upstream; }
+
+	// Bytes handed out since construction or the last release(), padding included
+	ND size_t bytes_used() const noexcept { return used; }
+
+private:
+	struct Chunk {
+		Chunk* next;
+		size_t bytes;
+	};
+
+	void* do_allocate(size_t bytes, size_t align) override {
+		char* p = align_up(cursor, align);
+		if (!cursor || static_cast<size_t>(last - p) < bytes) {
+			grow(bytes, align);
+			p = align_up(cursor, align);
+		}
+
+		used += (p - cursor) + bytes;
+		cursor = p + bytes;
+		return p;
+	}
+
+	void do_deallocate(void*, size_t, size_t) noexcept override {}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+	static char* align_up(char* p, size_t align) noexcept {
+		std::uintptr_t v = reinterpret_cast<std::uintptr_t>(p);
+		return p + ((align - v % align) % align);
+	}
+
+	void grow(size_t bytes, size_t align) {
+		size_t need = sizeof(Chunk) + bytes + align;
+		size_t size = next_size;
+		while (size < need)
+			size *= 2;
+
+		Chunk* c = static_cast<Chunk*>(upstream->allocate(size, alignof(Chunk)));
+		c->next = chunks;
+		c->bytes = size;
+		chunks = c;
+
+		cursor = reinterpret_cast<char*>(c + 1);
+		last = reinterpret_cast<char*>(c) + size;
+		if (next_size < max_chunk_size)
+			next_size *= 2;
+	}
+
+	std::pmr::memory_resource* upstream;
+	char* initial_buffer = nullptr;
+	size_t initial_size = 0;
+	char* cursor = nullptr;
+	char* last = nullptr;
+	size_t next_size = first_chunk_size;
+	size_t used = 0;
+	Chunk* chunks = nullptr;
+};
+
+
+#endif // !_Monotonic_Arena
@@ -0,0 +1,280 @@
+#ifndef _Pool_Allocator
+#define _Pool_Allocator
+
+#define ND [[nodiscard]]
+
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+
+// Fixed-size block pool. Blocks are carved out of large slabs with a bump pointer,
+// freed blocks go to an intrusive free list and are handed out again before the slab grows.
+// Slabs are only returned to the system as a whole. Not thread-safe.
+class Slab_pool {
+public:
+	static constexpr size_t first_slab_blocks = 64;
+	static constexpr size_t max_slab_blocks = size_t(1) << 16;
+
+	Slab_pool(size_t block_size, size_t block_align)
+		: align(block_align < alignof(Free_block) ? alignof(Free_block) : block_align),
+		  block(round_up(block_size < sizeof(Free_block) ? sizeof(Free_block) : block_size, align)) {}
+
+	Slab_pool(const Slab_pool&) = delete;
+	Slab_pool& operator=(const Slab_pool&) = delete;
+
+	~Slab_pool() { release_slabs(); }
+
+	ND void* allocate() {
+		++live;
+		if (free_list) {
+			Free_block* p = free_list;
+			free_list = p->next;
+			return p;
+		}
+
+		if (cursor == last)
+			grow();
+
+		void* p = cursor;
+		cursor += block;
+		return p;
+	}
+
+	// n blocks laid out back to back, block_size() bytes apart. Each one is still freed on its own with deallocate().
+	// Skips the free list; what is left of the current slab goes to the free list if the run does not fit in it
+	ND void* allocate_blocks(size_t n) {
+		if (static_cast<size_t>(last - cursor) < n * block)
+			grow(n);
+
+		live += n;
+		void* p = cursor;
+		cursor += n * block;
+		return p;
+	}
+
+	void deallocate(void* p) noexcept {
+		Free_block* b = static_cast<Free_block*>(p);
+		b->next = free_list;
+		free_list = b;
+		--live;
+	}
+
+	// Returns every slab to the system if no block is in use. Returns false otherwise.
+	bool release() noexcept {
+		if (live) return false;
+		release_slabs();
+		return true;
+	}
+
+	// Returns every slab to the system even if blocks are still live.
+	// The caller guarantees nothing is left in them that needs destruction or will be touched again.
+	void discard() noexcept {
+		release_slabs();
+		live = 0;
+	}
+
+	ND size_t block_size() const noexcept { return block; }
+
+	ND size_t block_alignment() const noexcept { return align; }
+
+	ND size_t live_blocks() const noexcept { return live; }
+
+	ND size_t slab_count() const noexcept { return slabs; }
+
+private:
+	struct Free_block {
+		Free_block* next;
+	};
+
+	struct Slab {
+		Slab* next;
+		size_t bytes;
+	};
+
+	static constexpr size_t round_up(size_t n, size_t a) noexcept {
+		return (n + a - 1) / a * a;
+	}
+
+	size_t header_size() const noexcept {
+		return round_up(sizeof(Slab), align);
+	}
+
+	// Starts a new slab with room for at least min_blocks, keeping the unused tail of the current one on the free list
+	void grow(size_t min_blocks = 1) {
+		for (; cursor != last; cursor += block) {
+			Free_block* b = reinterpret_cast<Free_block*>(cursor);
+			b->next = free_list;
+			free_list = b;
+		}
+
+		size_t blocks = next_blocks < min_blocks ? min_blocks : next_blocks;
+		size_t bytes = header_size() + blocks * block;
+		Slab* s = static_cast<Slab*>(::operator new(bytes, std::align_val_t(align)));
+		s->next = head;
+		s->bytes = bytes;
+		head = s;
+		++slabs;
+
+		cursor = reinterpret_cast<char*>(s) + header_size();
+		last = cursor + blocks * block;
+		if (next_blocks < max_slab_blocks)
+			next_blocks *= 2;
+	}
+
+	void release_slabs() noexcept {
+		while (head) {
+			Slab* next = head->next;
+			::operator delete(head, head->bytes, std::align_val_t(align));
+			head = next;
+		}
+
+		slabs = 0;
+		free_list = nullptr;
+		cursor = last = nullptr;
+		next_blocks = first_slab_blocks;
+	}
+
+	size_t align;
+	size_t block;
+	size_t live = 0;
+	size_t slabs = 0;
+	size_t next_blocks = first_slab_blocks;
+	Slab* head = nullptr;
+	Free_block* free_list = nullptr;
+	char* cursor = nullptr;
+	char* last = nullptr;
+};
+
+
+// Set of Slab_pools keyed by block size/alignment. Shared by an allocator and all its rebound copies,
+// so Pool_allocator<T> and the node allocator a container rebinds it to draw from the same resource.
+class Pool_resource {
+public:
+	Pool_resource() = default;
+	Pool_resource(const Pool_resource&) = delete;
+	Pool_resource& operator=(const Pool_resource&) = delete;
+
+	~Pool_resource() {
+		while (pools) {
+			Entry* next = pools->next;
+			delete pools;
+			pools = next;
+		}
+	}
+
+	ND Slab_pool& pool_for(size_t size, size_t align) {
+		for (Entry* e = pools; e; e = e->next) {
+			if (e->size == size && e->align == align)
+				return e->pool;
+		}
+
+		pools = new Entry{ pools, size, align, Slab_pool(size, align) };
+		return pools->pool;
+	}
+
+	// Releases the slabs of every pool that has no live blocks.
+	void release() noexcept {
+		for (Entry* e = pools; e; e = e->next)
+			e->pool.release();
+	}
+
+private:
+	struct Entry {
+		Entry* next;
+		size_t size;
+		size_t align;
+		Slab_pool pool;
+	};
+
+	Entry* pools = nullptr;
+};
+
+
+// Allocator that serves single-object requests from a Slab_pool. Multi-object requests go to operator new.
+// A default constructed allocator owns a fresh resource; copies and rebound copies share it and compare equal.
+// Copy construction of a container gets a fresh resource, moves and swaps carry it along with the nodes.
+template <typename T>
+class Pool_allocator {
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using difference_type	= std::ptrdiff_t;
+	using propagate_on_container_copy_assignment	= std::false_type;
+	using propagate_on_container_move_assignment	= std::true_type;
+	using propagate_on_container_swap				= std::true_type;
+	using is_always_equal							= std::false_type;
+
+	template <typename U>
+	struct rebind {
+		using other = Pool_allocator<U>;
+	};
+
+	template <typename U>
+	friend class Pool_allocator;
+
+
+	Pool_allocator() : res(std::make_shared<Pool_resource>()), pool(&res->pool_for(sizeof(T), alignof(T))) {}
+
+	// No move constructor on purpose: a moved-from allocator must stay usable and equal to the moved-to one.
+	Pool_allocator(const Pool_allocator&) = default;
+
+	template <typename U>
+	Pool_allocator(const Pool_allocator<U>& other) : res(other.res), pool(&res->pool_for(sizeof(T), alignof(T))) {}
+
+	// n objects back to back, each returned separately with deallocate(p, 1). Forward_list draws
+	// the nodes of count, copy and sized-range construction/insertion from a single call
+	ND T* allocate_blocks(size_type n) {
+		return static_cast<T*>(pool->allocate_blocks(n));
+	}
+
+	ND T* allocate(size_type n) {
+		if (n == 1)
+			return static_cast<T*>(pool->allocate());
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		if (n == 1)
+			pool->deallocate(p);
+		else
+			::operator delete(p, n * sizeof(T), std::align_val_t(alignof(T)));
+	}
+
+	Pool_allocator select_on_container_copy_construction() const {
+		return Pool_allocator();
+	}
+
+	// Hands the slabs of idle pools back to the system. Containers call it once they are emptied.
+	void release() noexcept {
+		res->release();
+	}
+
+	// Drops every slab of this allocator's pool, live objects included. Only valid when the caller owns
+	// all of them and none needs a destructor call, e.g. a list of trivially destructible elements being torn down.
+	void discard() noexcept {
+		pool->discard();
+	}
+
+	ND size_type live_blocks() const noexcept { return pool->live_blocks(); }
+
+	ND size_type slab_count() const noexcept { return pool->slab_count(); }
+
+	template <typename U>
+	bool operator==(const Pool_allocator<U>& other) const noexcept {
+		return res == other.res;
+	}
+
+	template <typename U>
+	bool operator!=(const Pool_allocator<U>& other) const noexcept {
+		return res != other.res;
+	}
+
+private:
+	std::shared_ptr<Pool_resource> res;
+	Slab_pool* pool;
+};
+
+
+#endif // !_Pool_Allocator
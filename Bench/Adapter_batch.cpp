@@ -0,0 +1,54 @@
+// Element-at-a-time push/pop vs push_range/pop_n/drain on Queue and Stack
+#include "../Queue/Queue.h"
+#include "../Stack/Stack.h"
+#include "Bench.h"
+
+#include <deque>
+#include <numeric>
+#include <vector>
+
+
+template <typename Adapter, typename Front>
+double one_by_one(const std::vector<int>& in, std::vector<int>& out, Front front) {
+	return Bench::best_of(5, [&] {
+		Adapter a;
+		for (int x : in)
+			a.push(x);
+		size_t i = 0;
+		while (!a.empty()) {
+			out[i++] = front(a);
+			a.pop();
+		}
+		Bench::do_not_optimize(out[0]);
+	});
+}
+
+template <typename Adapter>
+double batched(const std::vector<int>& in, std::vector<int>& out, size_t batch) {
+	return Bench::best_of(5, [&] {
+		Adapter a;
+		a.push_range(in.begin(), in.end());
+		int* dst = out.data();
+		while (!a.empty())
+			dst = a.pop_n(dst, batch);
+		Bench::do_not_optimize(out[0]);
+	});
+}
+
+int main() {
+	auto queue_front = [](auto& q) { return q.front(); };
+	auto stack_top = [](auto& s) { return s.top(); };
+
+	for (size_t n : { size_t(1000), size_t(100000), size_t(10000000) }) {
+		std::vector<int> in(n), out(n);
+		std::iota(in.begin(), in.end(), 0);
+
+		Bench::header("Queue<int> (std::deque) and Stack<int> (std::vector)");
+		Bench::report("Queue push/pop one by one", 2 * n, one_by_one<Queue<int>>(in, out, queue_front));
+		Bench::report("Queue push_range + pop_n(256)", 2 * n, batched<Queue<int>>(in, out, 256));
+		Bench::report("Queue push_range + drain", 2 * n, batched<Queue<int>>(in, out, n));
+		Bench::report("Stack push/pop one by one", 2 * n, one_by_one<Stack<int, std::vector<int>>>(in, out, stack_top));
+		Bench::report("Stack push_range + pop_n(256)", 2 * n, batched<Stack<int, std::vector<int>>>(in, out, 256));
+		Bench::report("Stack push_range + drain", 2 * n, batched<Stack<int, std::vector<int>>>(in, out, n));
+	}
+}
@@ -0,0 +1,128 @@
+#ifndef _Bench
+#define _Bench
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace Bench {
+
+	// Keeps the optimizer from discarding a computed value
+	template <typename T>
+	inline void do_not_optimize(const T& val) {
+		asm volatile("" : : "r,m"(val) : "memory");
+	}
+
+	// Wall time of a single f() call in milliseconds
+	template <typename F>
+	double time_ms(F&& f) {
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count();
+	}
+
+	// Runs f() `repeats` times and returns the best wall time in milliseconds
+	template <typename F>
+	double best_of(size_t repeats, F&& f) {
+		double best = 0;
+		for (size_t i = 0; i < repeats; ++i) {
+			double ms = time_ms(f);
+			if (i == 0 || ms < best)
+				best = ms;
+		}
+		return best;
+	}
+
+	inline void header(const char* title) {
+		std::printf("\n== %s\n", title);
+		std::printf("%-40s %12s %12s %14s\n", "case", "n", "ms", "Mops/s");
+	}
+
+	inline void report(const char* name, size_t n, double ms) {
+		std::printf("%-40s %12zu %12.3f %14.2f\n", name, n, ms, ms > 0 ? n / ms / 1000.0 : 0.0);
+		std::fflush(stdout);
+	}
+
+	// One JSON object of string and number fields, in insertion order
+	class Json_object {
+	public:
+		Json_object& add(const char* key, const std::string& value) {
+			start(key);
+			quote(value);
+			return *this;
+		}
+
+		Json_object& add(const char* key, const char* value) {
+			return add(key, std::string(value));
+		}
+
+		Json_object& add(const char* key, double value) {
+			char buf[32];
+			std::snprintf(buf, sizeof(buf), "%.6g", value);
+			start(key);
+			body += buf;
+			return *this;
+		}
+
+		Json_object& add(const char* key, size_t value) {
+			start(key);
+			body += std::to_string(value);
+			return *this;
+		}
+
+		std::string str() const {
+			return "{" + body + "}";
+		}
+
+	private:
+		void start(const char* key) {
+			if (!body.empty())
+				body += ", ";
+			quote(key);
+			body += ": ";
+		}
+
+		void quote(const std::string& text) {
+			body += '"';
+			for (char c : text) {
+				if (c == '"' || c == '\\') {
+					body += '\\';
+					body += c;
+				}
+				else if (static_cast<unsigned char>(c) < 0x20) {
+					char esc[8];
+					std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+					body += esc;
+				}
+				else
+					body += c;
+			}
+			body += '"';
+		}
+
+		std::string body;
+	};
+
+	// Writes {"context": context, "results": [rows...]} to path, one row per line so result files diff well.
+	// Returns false if the file could not be written
+	inline bool write_json(const char* path, const Json_object& context, const std::vector<Json_object>& rows) {
+		std::FILE* f = std::fopen(path, "w");
+		if (!f)
+			return false;
+
+		std::fprintf(f, "{\n\"context\": %s,\n\"results\": [\n", context.str().c_str());
+		for (size_t i = 0; i < rows.size(); ++i)
+			std::fprintf(f, "  %s%s\n", rows[i].str().c_str(), i + 1 < rows.size() ? "," : "");
+		std::fprintf(f, "]\n}\n");
+		return std::fclose(f) == 0;
+	}
+
+}
+
+
+#endif // !_Bench
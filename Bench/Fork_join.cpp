@@ -0,0 +1,152 @@
+// Fork_join_pool scaling from 1 to N workers against plain recursion, on recursive Fibonacci (tiny tasks,
+// measures scheduling overhead) and a binary tree sum (memory bound). Then the owner side of
+// Work_stealing_deque alone against the mutex-protected Stack it replaces as a per-thread task stack.
+// Usage: Fork_join [fib_n] [max_threads], defaults 34 and hardware_concurrency
+#include "../Thread_pool/Fork_join_pool.h"
+#include "../Stack/Stack.h"
+#include "../Stack/Work_stealing_deque.h"
+#include "Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+// Below this n (or above this tree depth) the recursion goes on serially
+static const int fib_cutoff = 16;
+static const int tree_cutoff = 8;
+
+long long fib_serial(int n) {
+	return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+long long fib(Fork_join_pool& pool, int n) {
+	if (n < fib_cutoff)
+		return fib_serial(n);
+
+	long long a, b;
+	pool.fork_join([&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+	return a + b;
+}
+
+struct Tree {
+	long long value;
+	std::unique_ptr<Tree> left, right;
+};
+
+std::unique_ptr<Tree> make_tree(int depth, long long& next) {
+	if (depth == 0)
+		return nullptr;
+
+	auto t = std::make_unique<Tree>();
+	t->value = next++;
+	t->left = make_tree(depth - 1, next);
+	t->right = make_tree(depth - 1, next);
+	return t;
+}
+
+long long tree_sum_serial(const Tree* t) {
+	return t ? t->value + tree_sum_serial(t->left.get()) + tree_sum_serial(t->right.get()) : 0;
+}
+
+long long tree_sum(Fork_join_pool& pool, const Tree* t, int depth) {
+	if (!t)
+		return 0;
+	if (depth <= tree_cutoff)
+		return tree_sum_serial(t);
+
+	long long l, r;
+	pool.fork_join([&] { l = tree_sum(pool, t->left.get(), depth - 1); },
+		[&] { r = tree_sum(pool, t->right.get(), depth - 1); });
+	return t->value + l + r;
+}
+
+int main(int argc, char** argv) {
+	int fib_n = argc > 1 ? std::atoi(argv[1]) : 34;
+	size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+	if (max_threads == 0)
+		max_threads = 1;
+
+	const int depth = 22;
+	long long next = 1;
+	auto tree = make_tree(depth, next);
+	size_t nodes = static_cast<size_t>(next - 1);
+
+	char title[64];
+	std::snprintf(title, sizeof(title), "fib(%d) and a %zu-node tree sum", fib_n, nodes);
+	Bench::header(title);
+
+	// n counts calls for fib, nodes for the tree
+	size_t calls = 0;
+	{
+		long long a = 1, b = 1;
+		for (int i = 1; i < fib_n; ++i) {
+			long long c = a + b + 1;
+			a = b;
+			b = c;
+		}
+		calls = static_cast<size_t>(b);
+	}
+
+	double ms = Bench::best_of(3, [&] { Bench::do_not_optimize(fib_serial(fib_n)); });
+	Bench::report("fib, serial", calls, ms);
+	ms = Bench::best_of(3, [&] { Bench::do_not_optimize(tree_sum_serial(tree.get())); });
+	Bench::report("tree sum, serial", nodes, ms);
+
+	for (size_t t = 1; t <= max_threads; t *= 2) {
+		Fork_join_pool pool(t);
+		if (pool.run([&] { return fib(pool, fib_n); }) != fib_serial(fib_n) ||
+			pool.run([&] { return tree_sum(pool, tree.get(), depth); }) != tree_sum_serial(tree.get())) {
+			std::printf("wrong result with %zu workers\n", t);
+			return 1;
+		}
+
+		char name[64];
+		ms = Bench::best_of(3, [&] { Bench::do_not_optimize(pool.run([&] { return fib(pool, fib_n); })); });
+		std::snprintf(name, sizeof(name), "fib, %zu workers", t);
+		Bench::report(name, calls, ms);
+
+		ms = Bench::best_of(3, [&] { Bench::do_not_optimize(pool.run([&] { return tree_sum(pool, tree.get(), depth); })); });
+		std::snprintf(name, sizeof(name), "tree sum, %zu workers", t);
+		Bench::report(name, nodes, ms);
+
+		if (t < max_threads && t * 2 > max_threads)
+			t = max_threads / 2;
+	}
+
+	// Owner-side push/pop, 8 deep, with no thieves around: the cost every fork pays
+	const size_t ops = 10000000;
+	Bench::header("per-thread task stack, push + pop");
+
+	Work_stealing_deque<void*> deque;
+	ms = Bench::best_of(3, [&] {
+		void* p = nullptr;
+		for (size_t i = 0; i < ops; i += 8) {
+			for (int k = 0; k < 8; ++k)
+				deque.push(&p);
+			for (int k = 0; k < 8; ++k)
+				Bench::do_not_optimize(deque.try_pop(p));
+		}
+	});
+	Bench::report("Work_stealing_deque", ops, ms);
+
+	Stack<void*> stack;
+	std::mutex m;
+	ms = Bench::best_of(3, [&] {
+		void* p = nullptr;
+		for (size_t i = 0; i < ops; i += 8) {
+			for (int k = 0; k < 8; ++k) {
+				std::lock_guard<std::mutex> lock(m);
+				stack.push(&p);
+			}
+			for (int k = 0; k < 8; ++k) {
+				std::lock_guard<std::mutex> lock(m);
+				p = stack.top();
+				stack.pop();
+			}
+		}
+	});
+	Bench::report("Stack behind a mutex", ops, ms);
+}
@@ -0,0 +1,78 @@
+// Append-only log on Forward_list: push_back vs the old push_front + reverse() idiom vs std::forward_list
+// with a caller-tracked last iterator, and concatenation of many small lists with append() vs splice_after.
+// Usage: Forward_list_append [max_elements], default 1e7
+#include "../Forward_list/Forward_list.h"
+#include "Bench.h"
+
+#include <forward_list>
+#include <vector>
+#include <cstdlib>
+
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	Bench::header("append n ints");
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		double ms = Bench::best_of(3, [&] {
+			Forward_list<int> log;
+			for (size_t i = 0; i < n; ++i)
+				log.push_back(static_cast<int>(i));
+			Bench::do_not_optimize(log.back());
+		});
+		Bench::report("Forward_list::push_back", n, ms);
+
+		ms = Bench::best_of(3, [&] {
+			Forward_list<int> log;
+			for (size_t i = 0; i < n; ++i)
+				log.push_front(static_cast<int>(i));
+			log.reverse();
+			Bench::do_not_optimize(log.front());
+		});
+		Bench::report("push_front + reverse", n, ms);
+
+		ms = Bench::best_of(3, [&] {
+			std::forward_list<int> log;
+			auto last = log.before_begin();
+			for (size_t i = 0; i < n; ++i)
+				last = log.insert_after(last, static_cast<int>(i));
+			Bench::do_not_optimize(*last);
+		});
+		Bench::report("std::forward_list::insert_after", n, ms);
+	}
+
+	Bench::header("concatenate n/16 lists of 16");
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		size_t parts = n / 16;
+		std::vector<Forward_list<int>> pieces(parts);
+		double ms = Bench::best_of(3, [&] {
+			for (auto& p : pieces) {
+				for (int i = 0; i < 16; ++i)
+					p.push_back(i);
+			}
+			Forward_list<int> all;
+			for (auto& p : pieces)
+				all.append(std::move(p));
+			Bench::do_not_optimize(all.size());
+		});
+		Bench::report("build + Forward_list::append", n, ms);
+
+		std::vector<std::forward_list<int>> std_pieces(parts);
+		ms = Bench::best_of(3, [&] {
+			for (auto& p : std_pieces) {
+				for (int i = 15; i >= 0; --i)
+					p.push_front(i);
+			}
+			// The splice itself is O(1) but the new last element has to be found by walking the piece
+			std::forward_list<int> all;
+			auto last = all.before_begin();
+			for (auto& p : std_pieces) {
+				all.splice_after(last, p);
+				while (std::next(last) != all.end())
+					++last;
+			}
+			Bench::do_not_optimize(*last);
+		});
+		Bench::report("build + std::forward_list::splice_after", n, ms);
+	}
+}
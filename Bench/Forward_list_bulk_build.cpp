@@ -0,0 +1,110 @@
+// Bulk construction of Forward_list from a vector, from a count and by copy: std::allocator (one allocation per node)
+// vs Pool_allocator (one contiguous run per call via allocate_blocks) vs std::forward_list.
+// Each case runs in a forked child so its peak RSS can be read from wait4() on its own.
+// Usage: Forward_list_bulk_build [max_elements], default 1e7
+#include "../Forward_list/Forward_list.h"
+#include "../Allocators/Pool_allocator.h"
+#include "Bench.h"
+
+#include <forward_list>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+// Runs f() in a child process, f returning the milliseconds it measured. Returns the child's peak RSS in MiB
+template <typename F>
+double run_forked(F&& f, double& ms) {
+	int fds[2];
+	ms = -1;
+	if (pipe(fds) != 0)
+		return -1;
+
+	pid_t pid = fork();
+	if (pid == 0) {
+		close(fds[0]);
+		double t = f();
+		ssize_t written = write(fds[1], &t, sizeof(t));
+		_exit(written == sizeof(t) ? 0 : 1);
+	}
+
+	close(fds[1]);
+	if (read(fds[0], &ms, sizeof(ms)) != sizeof(ms))
+		ms = -1;
+	close(fds[0]);
+
+	int status = 0;
+	struct rusage usage {};
+	wait4(pid, &status, 0, &usage);
+	return usage.ru_maxrss / 1024.0;
+}
+
+template <typename F>
+void measure(const char* name, size_t n, double baseline_mb, F&& f) {
+	double ms = 0;
+	double mb = run_forked(f, ms);
+	std::printf("%-40s %12zu %12.3f %14.2f %12.1f\n", name, n, ms, ms > 0 ? n / ms / 1000.0 : 0.0, mb - baseline_mb);
+	std::fflush(stdout);
+}
+
+// The lists are left to the child's _exit so teardown is neither timed nor needed
+template <typename List>
+double from_vector(const std::vector<int>& src) {
+	List* keep = nullptr;
+	double ms = Bench::time_ms([&] { keep = new List(src.begin(), src.end()); });
+	Bench::do_not_optimize(keep->front());
+	return ms;
+}
+
+template <typename List>
+double from_count(size_t n) {
+	List* keep = nullptr;
+	double ms = Bench::time_ms([&] { keep = new List(n, 42); });
+	Bench::do_not_optimize(keep->front());
+	return ms;
+}
+
+template <typename List>
+double by_copy(const std::vector<int>& src) {
+	List source(src.begin(), src.end());
+	List* keep = nullptr;
+	double ms = Bench::time_ms([&] { keep = new List(source); });
+	Bench::do_not_optimize(keep->front());
+	return ms;
+}
+
+int main(int argc, char** argv) {
+	using Std_list = Forward_list<int>;
+	using Pool_list = Forward_list<int, Pool_allocator<int>>;
+
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	for (size_t n = 10000; n <= max_n; n *= 10) {
+		std::vector<int> src(n);
+		for (size_t i = 0; i < n; ++i)
+			src[i] = static_cast<int>(i);
+
+		// Peak RSS of a child that builds nothing, subtracted from every case
+		double ms = 0;
+		double baseline = run_forked([] { return 0.0; }, ms);
+
+		std::printf("\n== build %zu ints\n", n);
+		std::printf("%-40s %12s %12s %14s %12s\n", "case", "n", "ms", "Mops/s", "peak MiB");
+
+		measure("range ctor, std::allocator", n, baseline, [&] { return from_vector<Std_list>(src); });
+		measure("range ctor, Pool_allocator", n, baseline, [&] { return from_vector<Pool_list>(src); });
+		measure("range ctor, std::forward_list", n, baseline, [&] { return from_vector<std::forward_list<int>>(src); });
+
+		measure("count ctor, std::allocator", n, baseline, [&] { return from_count<Std_list>(n); });
+		measure("count ctor, Pool_allocator", n, baseline, [&] { return from_count<Pool_list>(n); });
+		measure("count ctor, std::forward_list", n, baseline, [&] { return from_count<std::forward_list<int>>(n); });
+
+		// The source list is part of the child's peak here
+		measure("copy ctor, std::allocator", n, baseline, [&] { return by_copy<Std_list>(src); });
+		measure("copy ctor, Pool_allocator", n, baseline, [&] { return by_copy<Pool_list>(src); });
+		measure("copy ctor, std::forward_list", n, baseline, [&] { return by_copy<std::forward_list<int>>(src); });
+	}
+}
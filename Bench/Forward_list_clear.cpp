@@ -0,0 +1,55 @@
+// Cost of clear() and destruction for large lists of trivially destructible elements.
+// Usage: Forward_list_clear [max_elements], default 1e7 (1e8 needs several GB of memory)
+#include "../Forward_list/Forward_list.h"
+#include "../Allocators/Pool_allocator.h"
+#include "Bench.h"
+
+#include <forward_list>
+#include <cstdlib>
+
+
+template <typename List>
+List build(size_t n) {
+	List list;
+	for (size_t i = 0; i < n; ++i)
+		list.push_front(static_cast<typename List::value_type>(i));
+	return list;
+}
+
+template <typename List>
+double time_pop_loop(size_t n) {
+	List list = build<List>(n);
+	return Bench::time_ms([&] {
+		while (!list.empty())
+			list.pop_front();
+	});
+}
+
+template <typename List>
+double time_clear(size_t n) {
+	List list = build<List>(n);
+	return Bench::time_ms([&] { list.clear(); });
+}
+
+template <typename List>
+double time_destroy(size_t n) {
+	auto* list = new List(build<List>(n));
+	return Bench::time_ms([&] { delete list; });
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	using Plain = Forward_list<long>;
+	using Pooled = Forward_list<long, Pool_allocator<long>>;
+
+	Bench::header("teardown of Forward_list<long>");
+	for (size_t n = 1000000; n <= max_n; n *= 10) {
+		Bench::report("pop_front loop std::allocator", n, time_pop_loop<Plain>(n));
+		Bench::report("clear std::allocator", n, time_clear<Plain>(n));
+		Bench::report("clear Pool_allocator", n, time_clear<Pooled>(n));
+		Bench::report("destroy std::allocator", n, time_destroy<Plain>(n));
+		Bench::report("destroy Pool_allocator", n, time_destroy<Pooled>(n));
+		Bench::report("clear std::forward_list", n, time_clear<std::forward_list<long>>(n));
+	}
+}
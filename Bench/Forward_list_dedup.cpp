@@ -0,0 +1,51 @@
+// Global duplicate removal on an unsorted Forward_list<int>: dedup() (one hashed pass, keeps order) vs sort() + unique()
+// (O(n log n), loses the original order), for several duplicate ratios.
+// Usage: Forward_list_dedup [max_elements], default 1e7 (1e8 needs several GB)
+#include "../Forward_list/Forward_list.h"
+#include "Bench.h"
+
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+
+// Best of three timings of op on fresh copies of the same list; building the copy is not timed
+template <typename Op>
+double time_on_fresh(const std::vector<int>& keys, Op op) {
+	double best = 0;
+	for (int r = 0; r < 3; ++r) {
+		Forward_list<int> list(keys.begin(), keys.end());
+		double ms = Bench::time_ms([&] { op(list); });
+		Bench::do_not_optimize(list.size());
+		if (r == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	std::mt19937_64 rng(11);
+
+	for (size_t n = 1000000; n <= max_n; n *= 10) {
+		char title[64];
+		std::snprintf(title, sizeof(title), "%zu ints", n);
+		Bench::header(title);
+
+		// Number of distinct values as a fraction of n
+		for (double distinct : { 1.0, 0.5, 0.1, 0.001 }) {
+			size_t range = static_cast<size_t>(n * distinct);
+			std::vector<int> keys(n);
+			for (int& k : keys)
+				k = static_cast<int>(rng() % range);
+
+			char name[64];
+			std::snprintf(name, sizeof(name), "dedup, %g%% distinct", distinct * 100);
+			Bench::report(name, n, time_on_fresh(keys, [](Forward_list<int>& l) { l.dedup(); }));
+
+			std::snprintf(name, sizeof(name), "sort + unique, %g%% distinct", distinct * 100);
+			Bench::report(name, n, time_on_fresh(keys, [](Forward_list<int>& l) { l.sort(); l.unique(); }));
+		}
+	}
+}
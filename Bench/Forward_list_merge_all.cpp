@@ -0,0 +1,108 @@
+// Merging k sorted Forward_lists holding n elements in total: merge_all's loser tree vs folding the lists into
+// the first one with repeated merge calls (what a caller had to do before, O(n k)) and vs merging neighbours
+// pairwise in rounds (O(n log k), but every node is relinked log2(k) times). Building the lists is not timed.
+// Every round builds the lists in a fresh arena, taking nodes for the runs in a fixed random interleaving, so each
+// list is scattered among the others the same way every time, as runs produced over time would be.
+// Usage: Forward_list_merge_all [elements], default 1e6
+#include "../Forward_list/Forward_list.h"
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+
+template <typename T> T make_value(std::uint64_t key);
+
+template <> long make_value<long>(std::uint64_t key) {
+	return static_cast<long>(key);
+}
+
+template <> std::pmr::string make_value<std::pmr::string>(std::uint64_t key) {
+	char buf[32];
+	std::snprintf(buf, sizeof(buf), "run-%020llu", static_cast<unsigned long long>(key));
+	return std::pmr::string(buf);
+}
+
+// k sorted runs of about n / k random values each
+template <typename T>
+std::vector<std::vector<T>> make_runs(size_t n, size_t k) {
+	std::mt19937_64 rng(42);
+	std::vector<std::vector<T>> runs(k);
+	for (size_t i = 0; i < n; ++i)
+		runs[i % k].push_back(make_value<T>(rng() % (n * 4)));
+	for (auto& run : runs)
+		std::sort(run.begin(), run.end());
+	return runs;
+}
+
+template <typename T>
+using List = Forward_list<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T, typename Merge>
+void run(const char* name, const std::vector<std::vector<T>>& runs, const std::vector<std::uint32_t>& build_order,
+	size_t n, Merge merge) {
+	double best = 0;
+	for (int r = 0; r < 3; ++r) {
+		std::pmr::monotonic_buffer_resource arena;
+		std::vector<List<T>> lists;
+		lists.reserve(runs.size());
+		for (size_t i = 0; i < runs.size(); ++i)
+			lists.emplace_back(std::pmr::polymorphic_allocator<T>(&arena));
+
+		std::vector<size_t> next(runs.size());
+		for (std::uint32_t i : build_order)
+			lists[i].push_back(runs[i][next[i]++]);
+
+		double ms = Bench::time_ms([&] { merge(lists); });
+		Bench::do_not_optimize(lists[0].front());
+		if (r == 0 || ms < best)
+			best = ms;
+		if (ms > 1000)
+			break;	// one round is enough for the O(n k) cases
+	}
+
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s, k = %zu", name, runs.size());
+	Bench::report(label, n, best);
+}
+
+template <typename T>
+void run_all(const char* title, size_t n) {
+	Bench::header(title);
+	for (size_t k : { 2, 8, 64, 500 }) {
+		auto runs = make_runs<T>(n, k);
+		std::vector<std::uint32_t> build_order;
+		for (std::uint32_t i = 0; i < k; ++i)
+			build_order.insert(build_order.end(), runs[i].size(), i);
+		std::shuffle(build_order.begin(), build_order.end(), std::mt19937(7));
+
+		run<T>("repeated merge", runs, build_order, n, [](std::vector<List<T>>& lists) {
+			for (size_t i = 1; i < lists.size(); ++i)
+				lists[0].merge(lists[i]);
+		});
+		run<T>("pairwise rounds", runs, build_order, n, [](std::vector<List<T>>& lists) {
+			for (size_t step = 1; step < lists.size(); step *= 2) {
+				for (size_t i = 0; i + step < lists.size(); i += 2 * step)
+					lists[i].merge(lists[i + step]);
+			}
+		});
+		run<T>("merge_all", runs, build_order, n, [](std::vector<List<T>>& lists) {
+			List<T> out(lists[0].get_allocator());
+			out.merge_all(lists);
+			lists[0].swap(out);
+		});
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	run_all<long>("long", n);
+	run_all<std::pmr::string>("std::pmr::string (24 characters)", n / 4);
+}
@@ -0,0 +1,86 @@
+// Forward_list::parallel_sort scaling from 1 to N worker threads against the single-threaded sort.
+// Before timing, checks on keys with many duplicates that the result is sorted and stable.
+// Usage: Forward_list_parallel_sort [elements] [max_threads], defaults 1e7 and hardware_concurrency
+#include "../Forward_list/Forward_list.h"
+#include "../Thread_pool/Thread_pool.h"
+#include "Bench.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+
+struct Record {
+	unsigned key;
+	size_t seq;
+};
+
+struct By_key {
+	bool operator()(const Record& a, const Record& b) const { return a.key < b.key; }
+};
+
+Forward_list<Record> make_list(size_t n, unsigned distinct) {
+	std::mt19937 rng(7);
+	std::vector<Record> v(n);
+	for (size_t i = 0; i < n; ++i)
+		v[i] = { static_cast<unsigned>(rng() % distinct), i };
+	return Forward_list<Record>(v.begin(), v.end());
+}
+
+bool check_stable(size_t n, size_t threads) {
+	Thread_pool pool(threads);
+	Forward_list<Record> list = make_list(n, 100);
+	list.parallel_sort(pool, By_key());
+
+	size_t count = 0;
+	const Record* prev = nullptr;
+	for (const Record& r : list) {
+		if (prev && (r.key < prev->key || (r.key == prev->key && r.seq < prev->seq)))
+			return false;
+		prev = &r;
+		++count;
+	}
+	return count == n;
+}
+
+int main(int argc, char** argv) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+	if (max_threads == 0)
+		max_threads = 1;
+
+	// Odd thread counts leave an unpaired run in the merge rounds, exercise that path too
+	for (size_t t : { size_t(2), size_t(3), size_t(8) }) {
+		if (!check_stable(Forward_list<Record>::parallel_sort_grain * 11, t)) {
+			std::printf("parallel_sort is not stable with %zu threads\n", t);
+			return 1;
+		}
+	}
+
+	Bench::header("Forward_list<Record> sort");
+	double ms = Bench::best_of(3, [&] {
+		Forward_list<Record> list = make_list(n, 1u << 30);
+		list.sort(By_key());
+		Bench::do_not_optimize(list.front());
+	});
+	double build = Bench::best_of(3, [&] {
+		Forward_list<Record> list = make_list(n, 1u << 30);
+		Bench::do_not_optimize(list.front());
+	});
+	Bench::report("sort", n, ms - build);
+
+	for (size_t t = 1; t <= max_threads; t = t < max_threads && t * 2 > max_threads ? max_threads : t * 2) {
+		Thread_pool pool(t);
+		ms = Bench::best_of(3, [&] {
+			Forward_list<Record> list = make_list(n, 1u << 30);
+			list.parallel_sort(pool, By_key());
+			Bench::do_not_optimize(list.front());
+		});
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "parallel_sort, %zu threads", t);
+		Bench::report(name, n, ms - build);
+	}
+}
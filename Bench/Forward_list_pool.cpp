@@ -0,0 +1,63 @@
+// Push/pop throughput of Forward_list on std::allocator vs Pool_allocator
+#include "../Forward_list/Forward_list.h"
+#include "../Allocators/Pool_allocator.h"
+#include "Bench.h"
+
+#include <string>
+
+
+template <typename List>
+void fill_drain(size_t n, size_t rounds) {
+	List list;
+	for (size_t r = 0; r < rounds; ++r) {
+		for (size_t i = 0; i < n; ++i)
+			list.push_front(static_cast<typename List::value_type>(i));
+		while (!list.empty())
+			list.pop_front();
+	}
+	Bench::do_not_optimize(list.size());
+}
+
+template <typename List>
+void churn(size_t n, size_t rounds) {
+	List list;
+	for (size_t i = 0; i < n; ++i)
+		list.push_front(static_cast<typename List::value_type>(i));
+
+	for (size_t r = 0; r < rounds; ++r) {
+		for (size_t i = 0; i < n; ++i) {
+			list.push_front(static_cast<typename List::value_type>(i));
+			list.push_front(static_cast<typename List::value_type>(i));
+			list.pop_front();
+			list.erase_after(list.begin());
+		}
+	}
+	Bench::do_not_optimize(list.size());
+}
+
+template <typename T>
+void run(const char* type_name) {
+	const size_t rounds = 10;
+
+	Bench::header(type_name);
+	for (size_t n : { size_t(1) << 10, size_t(1) << 16, size_t(1) << 20 }) {
+		size_t ops = 2 * n * rounds;
+
+		double ms = Bench::best_of(3, [&] { fill_drain<Forward_list<T>>(n, rounds); });
+		Bench::report("fill/drain std::allocator", ops, ms);
+
+		ms = Bench::best_of(3, [&] { fill_drain<Forward_list<T, Pool_allocator<T>>>(n, rounds); });
+		Bench::report("fill/drain Pool_allocator", ops, ms);
+
+		ms = Bench::best_of(3, [&] { churn<Forward_list<T>>(n, rounds); });
+		Bench::report("churn std::allocator", 2 * ops, ms);
+
+		ms = Bench::best_of(3, [&] { churn<Forward_list<T, Pool_allocator<T>>>(n, rounds); });
+		Bench::report("churn Pool_allocator", 2 * ops, ms);
+	}
+}
+
+int main() {
+	run<int>("int");
+	run<double>("double");
+}
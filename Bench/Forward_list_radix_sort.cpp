@@ -0,0 +1,91 @@
+// Forward_list::radix_sort vs Forward_list::sort on integer keys: random 32-bit and 64-bit values, 64-bit
+// timestamps (the shared high bytes let radix_sort skip passes) and 64-byte records keyed by a 24-bit id.
+// Every round builds the list in a fresh arena, untimed, either with the nodes in allocation order, as in a
+// list just built, or scattered by relinking them in hash order first, as in a list that has lived a while.
+// Usage: Forward_list_radix_sort [max_elements], default 1e7; 1e8 needs about 3 GB
+#include "../Forward_list/Forward_list.h"
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+
+struct Record {
+	std::uint64_t id;
+	char payload[56];
+};
+
+template <typename T>
+using List = Forward_list<T, std::pmr::polymorphic_allocator<T>>;
+
+std::uint64_t mix(std::uint64_t x) {
+	x ^= x >> 31;
+	x *= 0x9e3779b97f4a7c15ull;
+	return x ^ (x >> 29);
+}
+
+template <typename T, typename Key, typename Sort>
+void run(const char* name, const std::vector<T>& values, bool scattered, Key key, Sort sort) {
+	int rounds = values.size() >= 10000000 ? 1 : 3;
+	double best = 0;
+	for (int r = 0; r < rounds; ++r) {
+		std::pmr::monotonic_buffer_resource arena;
+		List<T> list(values.begin(), values.end(), std::pmr::polymorphic_allocator<T>(&arena));
+		if (scattered)
+			list.radix_sort([&key](const T& x) { return mix(key(x)); });
+
+		double ms = Bench::time_ms([&] { sort(list); });
+		Bench::do_not_optimize(list.front());
+		if (r == 0 || ms < best)
+			best = ms;
+	}
+
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s, %s", name, scattered ? "scattered" : "in order");
+	Bench::report(label, values.size(), best);
+}
+
+template <typename T, typename Make, typename Key>
+void compare(const char* title, size_t max_n, Make make, Key key) {
+	Bench::header(title);
+	for (size_t n = std::min<size_t>(1000000, max_n); n <= max_n; n *= 10) {
+		std::mt19937_64 rng(42);
+		std::vector<T> values;
+		values.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			values.push_back(make(rng));
+
+		for (bool scattered : { false, true }) {
+			run("sort", values, scattered, key, [&key](List<T>& l) {
+				l.sort([&key](const T& a, const T& b) { return key(a) < key(b); });
+			});
+			run("radix_sort", values, scattered, key, [&key](List<T>& l) { l.radix_sort(key); });
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	compare<std::uint32_t>("random uint32_t (4 passes)", max_n,
+		[](std::mt19937_64& rng) { return static_cast<std::uint32_t>(rng()); },
+		[](std::uint32_t x) { return x; });
+
+	compare<std::uint64_t>("random uint64_t (8 passes)", max_n,
+		[](std::mt19937_64& rng) { return static_cast<std::uint64_t>(rng()); },
+		[](std::uint64_t x) { return x; });
+
+	// Nanosecond stamps over a day: only the low 6 bytes vary
+	compare<std::uint64_t>("uint64_t timestamps (6 passes)", max_n,
+		[](std::mt19937_64& rng) { return static_cast<std::uint64_t>(1700000000000000000ull + rng() % 86400000000000ull); },
+		[](std::uint64_t x) { return x; });
+
+	compare<Record>("64-byte records by 24-bit id (3 passes)", max_n / 10,
+		[](std::mt19937_64& rng) { return Record{ rng() % (1u << 24), {} }; },
+		[](const Record& r) { return r.id; });
+}
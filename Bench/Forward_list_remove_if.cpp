@@ -0,0 +1,68 @@
+// Filtering a large Forward_list whose nodes are scattered in memory, at several removal ratios:
+// remove_if (each match destroyed inside the scan) with and without prefetching vs extract_if, which only
+// unlinks the matches, timed with the extracted nodes dropped afterwards and with them handed back untouched.
+// Usage: Forward_list_remove_if [elements], default 1e6
+#include "../Forward_list/Forward_list.h"
+#include "Bench.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+
+struct Item {
+	std::uint32_t order;
+	std::uint32_t value;
+	std::string name;
+};
+
+using List = Forward_list<Item>;
+
+// The nodes are allocated in order and then relinked in random order by sorting on a random key,
+// so walking the list jumps around memory like a long-lived list does
+List make_scattered(size_t n, std::mt19937& rng) {
+	List list;
+	for (size_t i = 0; i < n; ++i)
+		list.push_back({ static_cast<std::uint32_t>(rng()), static_cast<std::uint32_t>(i), "item" });
+	list.sort([](const Item& a, const Item& b) { return a.order < b.order; });
+	return list;
+}
+
+template <typename Filter>
+void run(const char* name, size_t n, unsigned percent, Filter filter) {
+	std::mt19937 rng(5);
+	double best = 0;
+	for (int r = 0; r < 3; ++r) {
+		List list = make_scattered(n, rng);
+		List extracted;
+		double ms = Bench::time_ms([&] {
+			Bench::do_not_optimize(filter(list, extracted, [percent](const Item& x) { return x.value % 100 < percent; }));
+		});
+		if (r == 0 || ms < best)
+			best = ms;
+	}
+
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s, %u%% removed", name, percent);
+	Bench::report(label, n, best);
+}
+
+int main(int argc, char** argv) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	char title[64];
+	std::snprintf(title, sizeof(title), "%zu scattered nodes", n);
+	Bench::header(title);
+
+	for (unsigned percent : { 1u, 10u, 50u, 90u }) {
+		run("remove_if", n, percent, [](List& l, List&, auto p) { return l.remove_if(p); });
+		run("remove_if, prefetch", n, percent, [](List& l, List&, auto p) { return l.template remove_if<true>(p); });
+		run("extract_if + drop, prefetch", n, percent, [](List& l, List&, auto p) { return l.template extract_if<true>(p).size(); });
+		run("extract_if, prefetch", n, percent, [](List& l, List& out, auto p) {
+			out = l.template extract_if<true>(p);
+			return out.size();
+		});
+	}
+}
@@ -0,0 +1,125 @@
+// Range lookups on a sorted Forward_list<uint64_t>: summing the elements in [a, b) for random ranges of about
+// 100 elements, found by a linear scan (what a caller had to do before), by std::lower_bound over the list's
+// iterators (log n comparisons but O(n) steps) and by the skip index's lower_bound at several strides, plus
+// positional access, std::next against advance. Index builds are timed separately. The list is built in an arena
+// with the nodes in sorted order, as in a list built sorted, or scattered, as in one sorted after it was built.
+// Usage: Forward_list_skip_index [max_elements], sizes 1e5 up to it in steps of 10, default 1e7
+#include "../Forward_list/Forward_list.h"
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+
+using List = Forward_list<std::uint64_t, std::pmr::polymorphic_allocator<std::uint64_t>>;
+
+constexpr std::uint64_t range_width = 100;
+
+void report(const char* name, size_t n, size_t queries, double ms) {
+	std::printf("%-40s %12zu %10zu %14.3f\n", name, n, queries, ms * 1000.0 / static_cast<double>(queries));
+	std::fflush(stdout);
+}
+
+// Sums [a, a + range_width) starting from the first element not below a
+template <typename It, typename End>
+std::uint64_t sum_from(It it, End end, std::uint64_t a) {
+	std::uint64_t sum = 0;
+	for (; it != end && *it < a + range_width; ++it)
+		sum += *it;
+	return sum;
+}
+
+// Times `queries` lookups with find(a), best of 3, and reports microseconds per lookup
+template <typename Find>
+void run_lookups(const char* name, const List& list, const std::vector<std::uint64_t>& starts, size_t queries, Find find) {
+	queries = std::min(queries, starts.size());
+	double ms = Bench::best_of(3, [&] {
+		std::uint64_t total = 0;
+		for (size_t q = 0; q < queries; ++q)
+			total += sum_from(find(starts[q]), list.end(), starts[q]);
+		Bench::do_not_optimize(total);
+	});
+	report(name, list.size(), queries, ms);
+}
+
+void run_size(size_t n, bool scattered) {
+	// Keys spaced about 1 apart on average, so a range of range_width keys holds about 100 elements
+	std::mt19937_64 rng(42);
+	std::vector<std::uint64_t> values(n);
+	for (std::uint64_t& v : values)
+		v = rng() % n;
+	if (!scattered)
+		std::sort(values.begin(), values.end());
+
+	std::pmr::monotonic_buffer_resource arena;
+	List list(values.begin(), values.end(), std::pmr::polymorphic_allocator<std::uint64_t>(&arena));
+	if (scattered)
+		list.sort();
+
+	std::vector<std::uint64_t> starts(100000);
+	std::vector<size_t> positions(starts.size());
+	for (size_t i = 0; i < starts.size(); ++i) {
+		starts[i] = rng() % n;
+		positions[i] = static_cast<size_t>(rng() % n);
+	}
+
+	// A scan costs about n / 2 steps, so it gets enough lookups for about 1e7 steps
+	size_t scan_queries = std::max<size_t>(3, 20000000 / n);
+
+	run_lookups("linear scan", list, starts, scan_queries, [&](std::uint64_t a) {
+		return std::find_if(list.begin(), list.end(), [a](std::uint64_t x) { return x >= a; });
+	});
+	run_lookups("std::lower_bound", list, starts, scan_queries, [&](std::uint64_t a) {
+		return std::lower_bound(list.begin(), list.end(), a);
+	});
+
+	for (size_t stride : { 8, 32, 128 }) {
+		char name[64];
+		List::const_iterator probe;
+		double build = Bench::best_of(3, [&] {
+			list.build_index(stride);
+			probe = list.advance(0);
+		});
+		Bench::do_not_optimize(probe);
+		std::snprintf(name, sizeof(name), "build_index(%zu)", stride);
+		report(name, n, 1, build);
+
+		std::snprintf(name, sizeof(name), "lower_bound, stride %zu", stride);
+		run_lookups(name, list, starts, starts.size(), [&](std::uint64_t a) { return list.lower_bound(a); });
+	}
+
+	list.build_index();
+	size_t next_queries = scan_queries;
+	double ms = Bench::best_of(3, [&] {
+		std::uint64_t total = 0;
+		for (size_t q = 0; q < next_queries; ++q)
+			total += *std::next(list.begin(), static_cast<std::ptrdiff_t>(positions[q]));
+		Bench::do_not_optimize(total);
+	});
+	report("std::next", n, next_queries, ms);
+
+	ms = Bench::best_of(3, [&] {
+		std::uint64_t total = 0;
+		for (size_t q = 0; q < positions.size(); ++q)
+			total += *list.advance(positions[q]);
+		Bench::do_not_optimize(total);
+	});
+	report("advance, stride 32", n, positions.size(), ms);
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	for (bool scattered : { false, true }) {
+		std::printf("\n== sorted Forward_list<uint64_t>, %s, microseconds per lookup\n", scattered ? "scattered" : "in order");
+		std::printf("%-40s %12s %10s %14s\n", "case", "n", "lookups", "us");
+		for (size_t n = std::min<size_t>(100000, max_n); n <= max_n; n *= 10)
+			run_size(n, scattered);
+	}
+}
@@ -0,0 +1,68 @@
+// Forward_list::sort vs std::forward_list::sort on ints and on large payloads that are expensive to move.
+// Usage: Forward_list_sort [max_elements], default 1e6
+#include "../Forward_list/Forward_list.h"
+#include "Bench.h"
+
+#include <forward_list>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+
+struct Payload {
+	long key;
+	std::string name;
+	char blob[192];
+
+	Payload(long key) : key(key), name("payload-" + std::to_string(key)), blob{} {}
+
+	bool operator<(const Payload& other) const { return key < other.key; }
+};
+
+template <typename List>
+double time_sort(const std::vector<long>& keys) {
+	return Bench::best_of(3, [&] {
+		List list;
+		for (long k : keys)
+			list.emplace_front(k);
+		list.sort();
+		Bench::do_not_optimize(list.front());
+	});
+}
+
+template <typename List>
+double time_build(const std::vector<long>& keys) {
+	return Bench::best_of(3, [&] {
+		List list;
+		for (long k : keys)
+			list.emplace_front(k);
+		Bench::do_not_optimize(list.front());
+	});
+}
+
+template <typename T>
+void run(const char* title, size_t max_n) {
+	std::mt19937_64 rng(42);
+
+	Bench::header(title);
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		std::vector<long> keys(n);
+		for (auto& k : keys)
+			k = static_cast<long>(rng() % (n * 4));
+
+		// Construction is timed separately and subtracted so only the sort is reported
+		double build = time_build<Forward_list<T>>(keys);
+		Bench::report("Forward_list::sort", n, time_sort<Forward_list<T>>(keys) - build);
+
+		build = time_build<std::forward_list<T>>(keys);
+		Bench::report("std::forward_list::sort", n, time_sort<std::forward_list<T>>(keys) - build);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	run<long>("long", max_n);
+	run<Payload>("Payload (256 bytes, std::string member)", max_n / 10);
+}
@@ -0,0 +1,134 @@
+// Aggregation passes over a Forward_list<uint64_t>: reduce (sum), count_if, find_if (the match is the last element)
+// and transform_inplace, as a range-for loop over the iterators, as the plain members with and without Prefetch,
+// interleaved over a kept Split on one thread, and in parallel on 1 to max_threads workers, with a kept Split
+// and with the split pass that parallel_* makes without one. The list is built once per layout in an arena,
+// with the nodes in allocation order, as in a list just built, or scattered by relinking them in hash order,
+// as in a list that has lived a while.
+// Usage: Forward_list_traversal [elements] [max_threads], defaults 1e7 and hardware_concurrency; 1e8 needs 2.5 GB
+#include "../Forward_list/Forward_list.h"
+#include "../Thread_pool/Thread_pool.h"
+#include "Bench.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+
+using List = Forward_list<std::uint64_t, std::pmr::polymorphic_allocator<std::uint64_t>>;
+
+std::uint64_t mix(std::uint64_t x) {
+	x ^= x >> 31;
+	x *= 0x9e3779b97f4a7c15ull;
+	return x ^ (x >> 29);
+}
+
+void report(const char* op, const char* variant, size_t n, double ms) {
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s, %s", op, variant);
+	Bench::report(label, n, ms);
+}
+
+// Times each operation in one way of traversing; run(op) performs operation op (0 .. 3) and returns a checksum
+template <typename Run>
+void run_ops(const char* variant, size_t n, Run run) {
+	static const char* const ops[] = { "reduce", "count_if", "find_if", "transform_inplace" };
+	for (int op = 0; op < 4; ++op) {
+		double ms = Bench::best_of(3, [&] { Bench::do_not_optimize(run(op)); });
+		report(ops[op], variant, n, ms);
+	}
+}
+
+void run_layout(const char* title, List& list, size_t max_threads) {
+	Bench::header(title);
+	size_t n = list.size();
+	std::uint64_t last = 0;
+	for (std::uint64_t x : list)
+		last = x;
+
+	auto odd = [](std::uint64_t x) { return (x & 1) != 0; };
+	auto is_last = [last](std::uint64_t x) { return (x | 1) == (last | 1); };	// transform_inplace flips bit 0
+	auto flip = [](std::uint64_t x) { return x ^ 1; };
+
+	run_ops("range for", n, [&](int op) -> std::uint64_t {
+		std::uint64_t r = 0;
+		switch (op) {
+		case 0: for (std::uint64_t x : list) r += x; break;
+		case 1: for (std::uint64_t x : list) r += odd(x); break;
+		case 2: for (auto it = list.begin(); it != list.end(); ++it) if (is_last(*it)) { r = *it; break; } break;
+		case 3: for (std::uint64_t& x : list) x = flip(x); break;
+		}
+		return r;
+	});
+
+	auto serial = [&](auto prefetch) {
+		constexpr bool Prefetch = decltype(prefetch)::value;
+		return [&](int op) -> std::uint64_t {
+			switch (op) {
+			case 0: return list.reduce<Prefetch>(std::uint64_t(0), std::plus<>());
+			case 1: return list.count_if<Prefetch>(odd);
+			case 2: return *list.find_if<Prefetch>(is_last);
+			default: list.transform_inplace<Prefetch>(flip); return 0;
+			}
+		};
+	};
+	run_ops("members", n, serial(std::false_type()));
+	run_ops("members, Prefetch", n, serial(std::true_type()));
+
+	List::Split kept = list.split_into(List::traversal_streams * 8);
+	run_ops("Split, 1 thread", n, [&](int op) -> std::uint64_t {
+		switch (op) {
+		case 0: return list.reduce(kept, std::uint64_t(0), std::plus<>());
+		case 1: return list.count_if(kept, odd);
+		case 2: return *list.find_if(kept, is_last);
+		default: list.transform_inplace(kept, flip); return 0;
+		}
+	});
+
+	for (size_t t = 1; t <= max_threads; t = t < max_threads && t * 2 > max_threads ? max_threads : t * 2) {
+		Thread_pool pool(t);
+		List::Split split = list.split_into(t * List::traversal_streams * 8);
+		char variant[64];
+		std::snprintf(variant, sizeof(variant), "%zu threads, kept Split", t);
+		run_ops(variant, n, [&](int op) -> std::uint64_t {
+			switch (op) {
+			case 0: return list.parallel_reduce(pool, split, std::uint64_t(0), std::plus<>());
+			case 1: return list.parallel_count_if(pool, split, odd);
+			case 2: return *list.parallel_find_if(pool, split, is_last);
+			default: list.parallel_transform_inplace(pool, split, flip); return 0;
+			}
+		});
+
+		std::snprintf(variant, sizeof(variant), "%zu threads, split pass", t);
+		run_ops(variant, n, [&](int op) -> std::uint64_t {
+			switch (op) {
+			case 0: return list.parallel_reduce(pool, std::uint64_t(0), std::plus<>());
+			case 1: return list.parallel_count_if(pool, odd);
+			case 2: return *list.parallel_find_if(pool, is_last);
+			default: list.parallel_transform_inplace(pool, flip); return 0;
+			}
+		});
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+	if (max_threads == 0)
+		max_threads = 1;
+
+	std::vector<std::uint64_t> values(n);
+	for (size_t i = 0; i < n; ++i)
+		values[i] = mix(i + 1);
+
+	for (bool scattered : { false, true }) {
+		std::pmr::monotonic_buffer_resource arena;
+		List list(values.begin(), values.end(), std::pmr::polymorphic_allocator<std::uint64_t>(&arena));
+		if (scattered)
+			list.radix_sort([](std::uint64_t x) { return mix(x); });
+		run_layout(scattered ? "Forward_list<uint64_t>, scattered" : "Forward_list<uint64_t>, in order", list, max_threads);
+	}
+}
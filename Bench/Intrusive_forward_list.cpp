@@ -0,0 +1,110 @@
+// Scheduler-style link/unlink workload: tasks living in a pool move between a ready list and a wait list.
+// Intrusive_forward_list links the tasks themselves; Forward_list<Task*> allocates a node per link,
+// with std::allocator and with Pool_allocator.
+// Usage: Intrusive_forward_list [steps], default 1e7
+#include "../Forward_list/Forward_list.h"
+#include "../Forward_list/Intrusive_forward_list.h"
+#include "../Allocators/Pool_allocator.h"
+#include "Bench.h"
+
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+
+struct Task : Intrusive_hook<> {
+	unsigned state;
+	unsigned priority;
+
+	explicit Task(unsigned seed) : state(seed), priority(seed % 8) {}
+
+	// A little work per run. Returns true if the task blocks afterwards
+	bool run() {
+		state = state * 1664525u + 1013904223u;
+		return (state >> 28) < 5;
+	}
+};
+
+struct Intrusive_ops {
+	using List = Intrusive_forward_list<Task>;
+
+	static Task& take(List& l) {
+		Task& t = l.front();
+		l.pop_front();
+		return t;
+	}
+
+	static void put(List& l, Task& t) { l.push_back(t); }
+
+	static List make_like(List&) { return List(); }
+
+	static bool by_priority(const Task& a, const Task& b) { return a.priority < b.priority; }
+};
+
+template <typename Allocator>
+struct Pointer_ops {
+	using List = Forward_list<Task*, Allocator>;
+
+	static Task& take(List& l) {
+		Task* t = l.front();
+		l.pop_front();
+		return *t;
+	}
+
+	static void put(List& l, Task& t) { l.push_back(&t); }
+
+	// Splicing needs both lists on the same allocator
+	static List make_like(List& l) { return List(l.get_allocator()); }
+
+	static bool by_priority(const Task* a, const Task* b) { return a->priority < b->priority; }
+};
+
+// Each step the next ready task runs and goes to the back of the ready list, or to the wait list if it blocks.
+// Every 64 steps the waiting tasks are sorted by priority and appended to the ready list in one splice
+template <typename Ops>
+unsigned schedule(std::vector<Task>& tasks, size_t steps) {
+	typename Ops::List ready;
+	typename Ops::List waiting = Ops::make_like(ready);
+	for (Task& t : tasks)
+		Ops::put(ready, t);
+
+	unsigned checksum = 0;
+	for (size_t s = 0; s < steps; ++s) {
+		if (!ready.empty()) {
+			Task& t = Ops::take(ready);
+			checksum += t.state;
+			Ops::put(t.run() ? waiting : ready, t);
+		}
+
+		if (s % 64 == 63 || ready.empty()) {
+			waiting.sort(Ops::by_priority);
+			ready.append(std::move(waiting));
+		}
+	}
+	return checksum;
+}
+
+template <typename Ops>
+void run(const char* name, size_t task_count, size_t steps) {
+	std::vector<Task> tasks;
+	tasks.reserve(task_count);
+	for (size_t i = 0; i < task_count; ++i)
+		tasks.emplace_back(static_cast<unsigned>(i * 2654435761u));
+
+	double ms = Bench::best_of(3, [&] { Bench::do_not_optimize(schedule<Ops>(tasks, steps)); });
+	Bench::report(name, steps, ms);
+}
+
+int main(int argc, char** argv) {
+	size_t steps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	for (size_t tasks : { size_t(64), size_t(4096), size_t(262144) }) {
+		char title[64];
+		std::snprintf(title, sizeof(title), "scheduler, %zu tasks", tasks);
+		Bench::header(title);
+
+		run<Intrusive_ops>("Intrusive_forward_list", tasks, steps);
+		run<Pointer_ops<std::allocator<Task*>>>("Forward_list<Task*> std::allocator", tasks, steps);
+		run<Pointer_ops<Pool_allocator<Task*>>>("Forward_list<Task*> Pool_allocator", tasks, steps);
+	}
+}
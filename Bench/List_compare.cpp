@@ -0,0 +1,81 @@
+// Comparing two equal numeric lists (the worst case, every element is looked at) across element widths and lengths:
+// Unrolled_forward_list's run-wise SIMD compare_lists vs the same list compared element by element through
+// iterators (what compare_lists did before) vs Forward_list's compare_lists.
+// Usage: List_compare [max_elements], default 1e6
+#include "../Forward_list/Forward_list.h"
+#include "../Unrolled_forward_list/Unrolled_forward_list.h"
+#include "Bench.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+template <typename List>
+ListCompareResult compare_by_iterators(const List& lhs, const List& rhs) {
+	auto lit = lhs.begin(), rit = rhs.begin();
+	while (lit != lhs.end() && rit != rhs.end()) {
+		if (*lit < *rit) return ListCompareResult::Less;
+		if (*rit < *lit) return ListCompareResult::Greater;
+		++lit;
+		++rit;
+	}
+	if (lit == lhs.end() && rit == rhs.end()) return ListCompareResult::Equal;
+	if (lit == lhs.end()) return ListCompareResult::Less;
+	return ListCompareResult::Greater;
+}
+
+template <typename T>
+void run(const char* type_name, size_t max_n) {
+	char title[64];
+	std::snprintf(title, sizeof(title), "%s (%zu bytes)", type_name, sizeof(T));
+	Bench::header(title);
+
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		std::vector<T> values(n);
+		for (size_t i = 0; i < n; ++i)
+			values[i] = static_cast<T>(i * 7 % 101);
+
+		size_t repeats = max_n * 10 / n;
+		Unrolled_forward_list<T> ua(values.begin(), values.end()), ub(values.begin(), values.end());
+		Forward_list<T> fa(values.begin(), values.end()), fb(values.begin(), values.end());
+
+		// n counts every element compared over all repeats; the list length is in the case name
+		char name[64];
+		double ms = Bench::best_of(3, [&] {
+			for (size_t r = 0; r < repeats; ++r)
+				Bench::do_not_optimize(compare_lists(ua, ub));
+		});
+		std::snprintf(name, sizeof(name), "Unrolled compare_lists, len %zu", n);
+		Bench::report(name, n * repeats, ms);
+
+		ms = Bench::best_of(3, [&] {
+			for (size_t r = 0; r < repeats; ++r)
+				Bench::do_not_optimize(compare_by_iterators(ua, ub));
+		});
+		std::snprintf(name, sizeof(name), "Unrolled by iterators, len %zu", n);
+		Bench::report(name, n * repeats, ms);
+
+		ms = Bench::best_of(3, [&] {
+			for (size_t r = 0; r < repeats; ++r)
+				Bench::do_not_optimize(compare_lists(fa, fb));
+		});
+		std::snprintf(name, sizeof(name), "Forward_list compare_lists, len %zu", n);
+		Bench::report(name, n * repeats, ms);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	const char* level[] = { "scalar", "SSE2", "AVX2" };
+	std::printf("mismatch kernel: %s\n", level[static_cast<int>(simd_level())]);
+
+	run<std::int8_t>("int8_t", max_n);
+	run<std::int16_t>("int16_t", max_n);
+	run<std::int32_t>("int32_t", max_n);
+	run<std::int64_t>("int64_t", max_n);
+	run<float>("float", max_n);
+	run<double>("double", max_n);
+}
@@ -0,0 +1,149 @@
+// Priority_queue (d-ary heap, arity 2/4/8) against std::priority_queue on push/pop mixes of 64-bit keys:
+// fill then drain, a steady-state hold model (pop the top, push a later key, like a timer queue), and building
+// from a range. Then Handle_priority_queue's update() against the lazy-deletion idiom std::priority_queue forces
+// on a decrease-key workload.
+// Usage: Priority_queue [max_elements], default 1e6
+#include "../Priority_queue/Priority_queue.h"
+#include "Bench.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+
+using Key = std::uint64_t;
+using Min = std::greater<Key>;
+
+template <typename Q>
+void fill_drain(const char* name, const std::vector<Key>& keys) {
+	double ms = Bench::best_of(3, [&] {
+		Q q;
+		for (Key k : keys)
+			q.push(k);
+		Key sum = 0;
+		while (!q.empty()) {
+			sum += q.top();
+			q.pop();
+		}
+		Bench::do_not_optimize(sum);
+	});
+	Bench::report(name, keys.size(), ms);
+}
+
+// Starts from keys.size() pending keys; each step pops the earliest and schedules it again a random delay later
+template <typename Q>
+void hold(const char* name, const std::vector<Key>& keys, size_t steps) {
+	Q q;
+	for (Key k : keys)
+		q.push(k);
+
+	std::mt19937_64 rng(3);
+	double ms = Bench::time_ms([&] {
+		for (size_t i = 0; i < steps; ++i) {
+			Key now = q.top();
+			q.pop();
+			q.push(now + 1 + rng() % 1024);
+		}
+	});
+	Bench::do_not_optimize(q.top());
+	Bench::report(name, steps, ms);
+}
+
+template <typename Q>
+void build(const char* name, const std::vector<Key>& keys) {
+	double ms = Bench::best_of(3, [&] {
+		Q q(keys.begin(), keys.end());
+		Bench::do_not_optimize(q.top());
+	});
+	Bench::report(name, keys.size(), ms);
+}
+
+// n entries keep getting earlier deadlines: decrease-key moves the entry, the lazy idiom pushes a new copy and
+// skips stale ones when they reach the top
+void decrease_key(size_t n, size_t steps) {
+	std::mt19937_64 rng(5);
+	std::vector<Key> deadline(n);
+	for (Key& d : deadline)
+		d = (1ull << 40) + rng() % (1ull << 30);
+
+	double ms = Bench::best_of(3, [&] {
+		Handle_priority_queue<Key, Min> q;
+		std::vector<Handle_priority_queue<Key, Min>::Handle> handles(n);
+		std::vector<Key> current = deadline;
+		for (size_t i = 0; i < n; ++i)
+			handles[i] = q.push(current[i]);
+
+		std::mt19937_64 r(7);
+		for (size_t s = 0; s < steps; ++s) {
+			size_t i = r() % n;
+			current[i] -= 1 + r() % 4096;
+			q.update(handles[i], current[i]);
+		}
+		Key sum = 0;
+		while (!q.empty()) {
+			sum += q.top();
+			q.pop();
+		}
+		Bench::do_not_optimize(sum);
+	});
+	Bench::report("Handle_priority_queue update", steps, ms);
+
+	ms = Bench::best_of(3, [&] {
+		using Entry = std::pair<Key, std::uint32_t>;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> q;
+		std::vector<Key> current = deadline;
+		for (size_t i = 0; i < n; ++i)
+			q.push({ current[i], static_cast<std::uint32_t>(i) });
+
+		std::mt19937_64 r(7);
+		for (size_t s = 0; s < steps; ++s) {
+			size_t i = r() % n;
+			current[i] -= 1 + r() % 4096;
+			q.push({ current[i], static_cast<std::uint32_t>(i) });
+		}
+		Key sum = 0;
+		while (!q.empty()) {
+			Entry e = q.top();
+			q.pop();
+			if (e.first == current[e.second])
+				sum += e.first;
+		}
+		Bench::do_not_optimize(sum);
+	});
+	Bench::report("std::priority_queue lazy deletion", steps, ms);
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		std::mt19937_64 rng(n);
+		std::vector<Key> keys(n);
+		for (Key& k : keys)
+			k = rng() % (1ull << 40);
+
+		char title[64];
+		std::snprintf(title, sizeof(title), "%zu keys, min-queue", n);
+		Bench::header(title);
+
+		fill_drain<std::priority_queue<Key, std::vector<Key>, Min>>("fill + drain, std::priority_queue", keys);
+		fill_drain<Priority_queue<Key, std::vector<Key>, Min, 2>>("fill + drain, arity 2", keys);
+		fill_drain<Priority_queue<Key, std::vector<Key>, Min, 4>>("fill + drain, arity 4", keys);
+		fill_drain<Priority_queue<Key, std::vector<Key>, Min, 8>>("fill + drain, arity 8", keys);
+
+		size_t steps = 10 * max_n;
+		hold<std::priority_queue<Key, std::vector<Key>, Min>>("hold, std::priority_queue", keys, steps);
+		hold<Priority_queue<Key, std::vector<Key>, Min, 2>>("hold, arity 2", keys, steps);
+		hold<Priority_queue<Key, std::vector<Key>, Min, 4>>("hold, arity 4", keys, steps);
+		hold<Priority_queue<Key, std::vector<Key>, Min, 8>>("hold, arity 8", keys, steps);
+
+		build<std::priority_queue<Key, std::vector<Key>, Min>>("build, std::priority_queue", keys);
+		build<Priority_queue<Key, std::vector<Key>, Min, 4>>("build, arity 4", keys);
+
+		decrease_key(n, 4 * n);
+	}
+}
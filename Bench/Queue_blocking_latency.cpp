@@ -0,0 +1,108 @@
+// Enqueue-to-dequeue latency (p50/p99/p999) of a consumer blocked in pop_wait(): Blocking_queue (adaptive spin,
+// then futex parking) vs a mutex + condition variable queue that notifies on every push.
+// The producer sends back to back, with short busy gaps, and with sleeps long enough for the consumer to park.
+// Usage: Queue_blocking_latency [items], default 100000 (a tenth of that for the sleeping pattern)
+#include "../Queue/Queue.h"
+#include "../Queue/Blocking_queue.h"
+#include "Bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using Clock = std::chrono::steady_clock;
+
+struct Item {
+	long long stamp = 0;
+};
+
+static long long now_ns() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+
+class Condvar_queue {
+public:
+	void push(const Item& item) {
+		{
+			std::lock_guard<std::mutex> lock(m);
+			q.push(item);
+		}
+		ready.notify_one();
+	}
+
+	Item pop_wait() {
+		std::unique_lock<std::mutex> lock(m);
+		ready.wait(lock, [this] { return !q.empty(); });
+		Item item = q.front();
+		q.pop();
+		return item;
+	}
+
+private:
+	std::mutex m;
+	std::condition_variable ready;
+	Queue<Item> q;
+};
+
+enum class Gap {
+	None,
+	Busy_2us,
+	Sleep_100us
+};
+
+static void wait_gap(Gap gap) {
+	if (gap == Gap::Busy_2us) {
+		long long until = now_ns() + 2000;
+		while (now_ns() < until) {}
+	}
+	else if (gap == Gap::Sleep_100us)
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+template <typename Q>
+void run(const char* name, Gap gap, size_t items) {
+	Q q;
+	std::vector<long long> samples(items);
+
+	double ms = Bench::time_ms([&] {
+		std::thread consumer([&] {
+			for (size_t i = 0; i < items; ++i) {
+				Item item = q.pop_wait();
+				samples[i] = now_ns() - item.stamp;
+			}
+		});
+
+		for (size_t i = 0; i < items; ++i) {
+			q.push(Item{ now_ns() });
+			wait_gap(gap);
+		}
+		consumer.join();
+	});
+
+	std::sort(samples.begin(), samples.end());
+	auto pct = [&](double p) { return samples[static_cast<size_t>(p * (samples.size() - 1))]; };
+
+	std::printf("%-24s %10zu %12.3f %12lld %12lld %12lld\n", name, items, ms, pct(0.5), pct(0.99), pct(0.999));
+	std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+	size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+	const char* titles[] = { "back to back", "2 us busy gaps", "100 us sleeps" };
+	for (Gap gap : { Gap::None, Gap::Busy_2us, Gap::Sleep_100us }) {
+		size_t n = gap == Gap::Sleep_100us ? std::max<size_t>(items / 10, 1) : items;
+
+		std::printf("\n== %s\n", titles[static_cast<int>(gap)]);
+		std::printf("%-24s %10s %12s %12s %12s %12s\n", "queue", "items", "ms", "p50 ns", "p99 ns", "p999 ns");
+		run<Condvar_queue>("mutex + condvar", gap, n);
+		run<Blocking_queue<Item>>("Blocking_queue", gap, n);
+	}
+}
@@ -0,0 +1,111 @@
+// MPMC_queue vs a mutex-wrapped Queue: throughput and enqueue-to-dequeue latency
+// for 1/2/4/8/16 producer-consumer pairs.
+// Usage: Queue_concurrent [items_per_producer], default 200000
+#include "../Queue/Queue.h"
+#include "../Queue/MPMC_queue.h"
+#include "Bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using Clock = std::chrono::steady_clock;
+
+struct Item {
+	long long stamp;
+};
+
+static long long now_ns() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+
+class Locked_queue {
+public:
+	void push(const Item& item) {
+		std::lock_guard<std::mutex> lock(m);
+		q.push(item);
+	}
+
+	bool try_pop(Item& out) {
+		std::lock_guard<std::mutex> lock(m);
+		if (q.empty())
+			return false;
+		out = q.front();
+		q.pop();
+		return true;
+	}
+
+private:
+	std::mutex m;
+	Queue<Item> q;
+};
+
+
+template <typename Q>
+void run(const char* name, Q& q, size_t pairs, size_t per_producer) {
+	std::atomic<bool> go{ false };
+	std::atomic<size_t> consumed{ 0 };
+	const size_t total = pairs * per_producer;
+	std::vector<std::vector<long long>> latencies(pairs);
+	std::vector<std::thread> threads;
+
+	for (size_t p = 0; p < pairs; ++p) {
+		threads.emplace_back([&] {
+			while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+			for (size_t i = 0; i < per_producer; ++i)
+				q.push(Item{ now_ns() });
+		});
+
+		threads.emplace_back([&, p] {
+			auto& samples = latencies[p];
+			samples.reserve(per_producer / 16 + 1);
+			Item item;
+			size_t n = 0;
+			while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+			while (consumed.load(std::memory_order_relaxed) < total) {
+				if (q.try_pop(item)) {
+					if (n++ % 16 == 0)
+						samples.push_back(now_ns() - item.stamp);
+					consumed.fetch_add(1, std::memory_order_relaxed);
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	double ms = Bench::time_ms([&] {
+		go.store(true, std::memory_order_release);
+		for (auto& t : threads)
+			t.join();
+	});
+
+	std::vector<long long> all;
+	for (auto& v : latencies)
+		all.insert(all.end(), v.begin(), v.end());
+	std::sort(all.begin(), all.end());
+	auto pct = [&](double q) { return all.empty() ? 0LL : all[static_cast<size_t>(q * (all.size() - 1))]; };
+
+	std::printf("%-24s %6zu %12.3f %12.2f %12lld %12lld\n", name, pairs, ms, total / ms / 1000.0, pct(0.5), pct(0.99));
+	std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+	size_t per_producer = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+	std::printf("%-24s %6s %12s %12s %12s %12s\n", "queue", "pairs", "ms", "Mops/s", "p50 ns", "p99 ns");
+	for (size_t pairs : { 1, 2, 4, 8, 16 }) {
+		Locked_queue locked;
+		run("mutex + Queue", locked, pairs, per_producer);
+
+		MPMC_queue<Item> lock_free(4096);
+		run("MPMC_queue", lock_free, pairs, per_producer);
+	}
+}
@@ -0,0 +1,103 @@
+// Queue on Ring_buffer vs Queue on std::deque: single-thread ops/sec and SPSC hand-off ops/sec with p99 latency.
+// Usage: Queue_ring_buffer [items], default 2000000
+#include "../Queue/Queue.h"
+#include "../Queue/Ring_buffer.h"
+#include "Bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+static long long now_ns() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename Q>
+void single_thread(const char* name, size_t n) {
+	double ms = Bench::best_of(3, [&] {
+		Q q;
+		long sum = 0;
+		for (size_t i = 0; i < n; ++i) {
+			q.push(static_cast<long>(i));
+			if (q.size() > 512) {
+				sum += q.front();
+				q.pop();
+			}
+		}
+		while (!q.empty()) {
+			sum += q.front();
+			q.pop();
+		}
+		Bench::do_not_optimize(sum);
+	});
+	Bench::report(name, 2 * n, ms);
+}
+
+struct Spsc_result {
+	double ms;
+	long long p50, p99;
+};
+
+template <typename TryPush, typename TryPop>
+Spsc_result hand_off(size_t n, TryPush try_push, TryPop try_pop) {
+	std::vector<long long> samples;
+	samples.reserve(n / 16 + 1);
+
+	double ms = Bench::time_ms([&] {
+		std::thread producer([&] {
+			for (size_t i = 0; i < n; ++i) {
+				while (!try_push(now_ns()))
+					std::this_thread::yield();
+			}
+		});
+
+		long long stamp;
+		for (size_t i = 0; i < n; ++i) {
+			while (!try_pop(stamp))
+				std::this_thread::yield();
+			if (i % 16 == 0)
+				samples.push_back(now_ns() - stamp);
+		}
+		producer.join();
+	});
+
+	std::sort(samples.begin(), samples.end());
+	return { ms, samples[samples.size() / 2], samples[samples.size() * 99 / 100] };
+}
+
+void print_spsc(const char* name, size_t n, Spsc_result r) {
+	std::printf("%-40s %12zu %12.3f %14.2f %10lld %10lld\n", name, n, r.ms, n / r.ms / 1000.0, r.p50, r.p99);
+	std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+	Bench::header("single thread, ~512 elements in flight");
+	single_thread<Queue<long>>("Queue<long, std::deque>", n);
+	single_thread<Queue<long, Ring_buffer<long, 1024>>>("Queue<long, Ring_buffer<1024>>", n);
+
+	std::printf("\n== SPSC hand-off between two threads\n");
+	std::printf("%-40s %12s %12s %14s %10s %10s\n", "case", "n", "ms", "Mops/s", "p50 ns", "p99 ns");
+
+	{
+		std::mutex m;
+		Queue<long long> q;
+		print_spsc("mutex + Queue<std::deque>", n, hand_off(n,
+			[&](long long v) { std::lock_guard<std::mutex> lock(m); if (q.size() >= 1024) return false; q.push(v); return true; },
+			[&](long long& out) { std::lock_guard<std::mutex> lock(m); if (q.empty()) return false; out = q.front(); q.pop(); return true; }));
+	}
+
+	{
+		auto* ring = new Ring_buffer<long long, 1024>();
+		print_spsc("Ring_buffer<1024> wait-free SPSC", n, hand_off(n,
+			[&](long long v) { return ring->try_push_back(v); },
+			[&](long long& out) { return ring->try_pop_front(out); }));
+		delete ring;
+	}
+}
@@ -0,0 +1,73 @@
+// Request-scoped workload: every "request" builds a list, a stack and a queue, uses them and throws them away.
+// Global heap (std containers) vs pmr containers on a Monotonic_arena released when the request ends
+#include "../Forward_list/Forward_list.h"
+#include "../Stack/Stack.h"
+#include "../Queue/Queue.h"
+#include "../Allocators/Monotonic_arena.h"
+#include "Bench.h"
+
+#include <cstdlib>
+
+
+template <typename List, typename St, typename Qu, typename... Alloc>
+size_t serve(size_t items, const Alloc&... alloc) {
+	List list(alloc...);
+	for (size_t i = 0; i < items; ++i)
+		list.push_front(static_cast<int>(i * 2654435761u >> 7));
+	list.sort();
+
+	St stack(alloc...);
+	Qu queue(alloc...);
+	for (int x : list) {
+		stack.push(x);
+		if (x & 1)
+			queue.push(x);
+	}
+
+	size_t sum = 0;
+	while (!queue.empty()) {
+		sum += queue.front();
+		queue.pop();
+	}
+	while (!stack.empty()) {
+		sum += stack.top();
+		stack.pop();
+	}
+	return sum;
+}
+
+void heap_requests(size_t requests, size_t items) {
+	size_t sum = 0;
+	for (size_t r = 0; r < requests; ++r)
+		sum += serve<Forward_list<int>, Stack<int>, Queue<int>>(items);
+	Bench::do_not_optimize(sum);
+}
+
+void arena_requests(size_t requests, size_t items) {
+	alignas(std::max_align_t) static char buffer[64 * 1024];
+	Monotonic_arena arena(buffer, sizeof(buffer));
+	std::pmr::polymorphic_allocator<int> alloc(&arena);
+
+	size_t sum = 0;
+	for (size_t r = 0; r < requests; ++r) {
+		sum += serve<pmr::Forward_list<int>, pmr::Stack<int>, pmr::Queue<int>>(items, alloc);
+		arena.release();
+	}
+	Bench::do_not_optimize(sum);
+}
+
+int main(int argc, char** argv) {
+	size_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 22;
+
+	Bench::header("request-scoped list + stack + queue");
+	for (size_t items : { size_t(16), size_t(256), size_t(4096), size_t(65536) }) {
+		size_t requests = total / items;
+		size_t ops = requests * items;
+
+		double ms = Bench::best_of(3, [&] { heap_requests(requests, items); });
+		Bench::report("global heap", ops, ms);
+
+		ms = Bench::best_of(3, [&] { arena_requests(requests, items); });
+		Bench::report("Monotonic_arena", ops, ms);
+	}
+}
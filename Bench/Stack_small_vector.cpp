@@ -0,0 +1,58 @@
+// Short-lived stacks: create, push k, pop all, destroy, on std::deque, std::vector and Small_vector backings.
+// Also counts calls to operator new per cycle.
+#include "../Stack/Stack.h"
+#include "../Stack/Small_vector.h"
+#include "Bench.h"
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+
+static size_t allocations = 0;
+
+void* operator new(size_t n) {
+	++allocations;
+	if (void* p = std::malloc(n ? n : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+
+template <typename S>
+void run(const char* name, size_t depth, size_t cycles) {
+	size_t before = allocations;
+	double ms = Bench::best_of(3, [&] {
+		long sum = 0;
+		for (size_t c = 0; c < cycles; ++c) {
+			S s;
+			for (size_t i = 0; i < depth; ++i)
+				s.push(static_cast<int>(i + c));
+			while (!s.empty()) {
+				sum += s.top();
+				s.pop();
+			}
+		}
+		Bench::do_not_optimize(sum);
+	});
+
+	char label[64];
+	std::snprintf(label, sizeof(label), "%s (%.1f new/cycle)", name, double(allocations - before) / (3.0 * cycles));
+	Bench::report(label, cycles, ms);
+}
+
+int main() {
+	const size_t cycles = 1000000;
+	for (size_t depth : { 4, 12, 32, 100 }) {
+		char title[64];
+		std::snprintf(title, sizeof(title), "create/push %zu/pop/destroy cycles", depth);
+		Bench::header(title);
+		run<Stack<int>>("std::deque", depth, cycles);
+		run<Stack<int, std::vector<int>>>("std::vector", depth, cycles);
+		run<Stack<int, Small_vector<int, 16>>>("Small_vector<16>", depth, cycles);
+	}
+}
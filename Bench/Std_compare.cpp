@@ -0,0 +1,261 @@
+// The containers against their standard counterparts: Forward_list vs std::forward_list, Stack vs std::stack and
+// Queue vs std::queue (both adapters over std::deque), for int, a 64-byte POD and std::string (24 characters,
+// past the small-string buffer), at every size from 1e3 up to max_elements in steps of 10.
+// Every case processes about max_elements elements per round, by repeating the operation on smaller containers;
+// setup and teardown are not timed, the two containers alternate and the best of 5 rounds is kept. Inputs come from a fixed seed, so runs
+// are comparable across builds. With json_file the results are also written there as JSON: the build context,
+// then one row per operation, element type and size with both containers' ns per element and their ratio.
+// Usage: Std_compare [max_elements] [json_file], default 1e6
+#include "../Forward_list/Forward_list.h"
+#include "../Queue/Queue.h"
+#include "../Stack/Stack.h"
+#include "Bench.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <forward_list>
+#include <queue>
+#include <random>
+#include <stack>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE "unknown"
+#endif
+
+#ifndef BENCH_CXX_FLAGS
+#define BENCH_CXX_FLAGS "unknown"
+#endif
+
+
+struct Pod64 {
+	std::uint64_t key;
+	std::uint64_t payload[7];
+
+	bool operator<(const Pod64& other) const { return key < other.key; }
+};
+
+static_assert(sizeof(Pod64) == 64, "Pod64 should be 64 bytes");
+
+template <typename T> T make_value(std::uint32_t key);
+
+template <> int make_value<int>(std::uint32_t key) {
+	return static_cast<int>(key);
+}
+
+template <> Pod64 make_value<Pod64>(std::uint32_t key) {
+	Pod64 p{};
+	p.key = key;
+	return p;
+}
+
+template <> std::string make_value<std::string>(std::uint32_t key) {
+	char buf[32];
+	std::snprintf(buf, sizeof(buf), "key-%020u", key);
+	return buf;
+}
+
+std::uint64_t key_of(int x) { return static_cast<std::uint32_t>(x); }
+std::uint64_t key_of(const Pod64& x) { return x.key; }
+std::uint64_t key_of(const std::string& x) { return static_cast<unsigned char>(x.back()); }
+
+template <typename T>
+std::vector<T> make_values(size_t n) {
+	std::mt19937 rng(42);
+	std::vector<T> values;
+	values.reserve(n);
+	for (size_t i = 0; i < n; ++i)
+		values.push_back(make_value<T>(static_cast<std::uint32_t>(rng())));
+	return values;
+}
+
+// Total time of `reps` calls of op(state), each on a fresh setup(); the state is built and destroyed
+// outside the timed section
+template <typename Setup, typename Op>
+double time_round(size_t reps, Setup& setup, Op& op) {
+	std::chrono::steady_clock::duration total{};
+	for (size_t i = 0; i < reps; ++i) {
+		auto state = setup();
+		auto start = std::chrono::steady_clock::now();
+		op(state);
+		total += std::chrono::steady_clock::now() - start;
+	}
+	return std::chrono::duration<double, std::milli>(total).count();
+}
+
+struct Suite {
+	size_t max_n;
+	std::vector<Bench::Json_object> rows;
+
+	// Times one operation on both containers and reports ns per element
+	template <typename Ours_setup, typename Std_setup, typename Op>
+	void compare(const char* group, const char* op_name, const char* type_name, size_t n,
+		Ours_setup ours_setup, Std_setup std_setup, Op op) {
+		constexpr int rounds = 5;
+		size_t reps = std::max<size_t>(1, max_n / n);
+
+		// The two containers alternate, after an untimed round each, so neither sees a colder heap or cache
+		time_round(reps, ours_setup, op);
+		time_round(reps, std_setup, op);
+		double ours_ms = 0, std_ms = 0;
+		for (int r = 0; r < rounds; ++r) {
+			double ms = time_round(reps, ours_setup, op);
+			if (r == 0 || ms < ours_ms)
+				ours_ms = ms;
+			ms = time_round(reps, std_setup, op);
+			if (r == 0 || ms < std_ms)
+				std_ms = ms;
+		}
+
+		double elements = static_cast<double>(n) * static_cast<double>(reps);
+		double ours_ns = ours_ms * 1e6 / elements;
+		double std_ns = std_ms * 1e6 / elements;
+		double ratio = ours_ns > 0 ? std_ns / ours_ns : 0.0;
+
+		std::printf("%-14s %-10s %-12s %10zu %12.2f %12.2f %9.2fx\n", group, op_name, type_name, n, ours_ns, std_ns, ratio);
+		std::fflush(stdout);
+
+		Bench::Json_object row;
+		row.add("group", group).add("operation", op_name).add("type", type_name).add("n", n).add("repeats", reps)
+			.add("ns_per_element", ours_ns).add("std_ns_per_element", std_ns).add("speedup_vs_std", ratio);
+		rows.push_back(row);
+	}
+};
+
+template <typename T>
+void lists(Suite& suite, const char* type_name, size_t n) {
+	using Ours = Forward_list<T>;
+	using Std = std::forward_list<T>;
+	std::vector<T> values = make_values<T>(n);
+
+	auto empty_ours = [] { return Ours(); };
+	auto empty_std = [] { return Std(); };
+	auto filled_ours = [&] { return Ours(values.begin(), values.end()); };
+	auto filled_std = [&] { return Std(values.begin(), values.end()); };
+
+	suite.compare("forward_list", "push_front", type_name, n, empty_ours, empty_std, [&](auto& l) {
+		for (const T& v : values)
+			l.push_front(v);
+	});
+	suite.compare("forward_list", "iterate", type_name, n, filled_ours, filled_std, [](auto& l) {
+		std::uint64_t sum = 0;
+		for (const T& v : l)
+			sum += key_of(v);
+		Bench::do_not_optimize(sum);
+	});
+	suite.compare("forward_list", "sort", type_name, n, filled_ours, filled_std, [](auto& l) {
+		l.sort();
+	});
+	suite.compare("forward_list", "remove_if", type_name, n, filled_ours, filled_std, [](auto& l) {
+		l.remove_if([](const T& v) { return key_of(v) & 1; });
+		Bench::do_not_optimize(l);
+	});
+	suite.compare("forward_list", "reverse", type_name, n, filled_ours, filled_std, [](auto& l) {
+		l.reverse();
+		Bench::do_not_optimize(l);
+	});
+	suite.compare("forward_list", "clear", type_name, n, filled_ours, filled_std, [](auto& l) {
+		l.clear();
+		Bench::do_not_optimize(l);
+	});
+}
+
+// Stack and Queue: push_all fills an empty adapter, pop_all empties a full one and push_pop keeps n resident
+// while pushing and popping one element at a time
+template <typename Ours, typename Std, typename T, typename Next>
+void adapters(Suite& suite, const char* group, const char* type_name, size_t n, Next next) {
+	std::vector<T> values = make_values<T>(n);
+
+	auto empty_ours = [] { return Ours(); };
+	auto empty_std = [] { return Std(); };
+	// Both are filled the same way, so they start from the same deque layout
+	auto fill = [&](auto a) {
+		for (const T& v : values)
+			a.push(v);
+		return a;
+	};
+	auto filled_ours = [&] { return fill(Ours()); };
+	auto filled_std = [&] { return fill(Std()); };
+
+	suite.compare(group, "push_all", type_name, n, empty_ours, empty_std, [&](auto& a) {
+		for (const T& v : values)
+			a.push(v);
+	});
+	suite.compare(group, "pop_all", type_name, n, filled_ours, filled_std, [&](auto& a) {
+		std::uint64_t sum = 0;
+		while (!a.empty()) {
+			sum += key_of(next(a));
+			a.pop();
+		}
+		Bench::do_not_optimize(sum);
+	});
+	suite.compare(group, "push_pop", type_name, n, filled_ours, filled_std, [&](auto& a) {
+		std::uint64_t sum = 0;
+		for (const T& v : values) {
+			a.push(v);
+			sum += key_of(next(a));
+			a.pop();
+		}
+		Bench::do_not_optimize(sum);
+	});
+}
+
+template <typename T>
+void run(Suite& suite, const char* type_name) {
+	for (size_t n = 1000; n <= suite.max_n; n *= 10) {
+		lists<T>(suite, type_name, n);
+		adapters<Stack<T>, std::stack<T>, T>(suite, "stack", type_name, n, [](auto& s) -> const T& { return s.top(); });
+		adapters<Queue<T>, std::queue<T>, T>(suite, "queue", type_name, n, [](auto& q) -> const T& { return q.front(); });
+	}
+}
+
+std::string utc_timestamp() {
+	std::time_t now = std::time(nullptr);
+	char buf[32];
+	std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+	return buf;
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	const char* json_path = argc > 2 ? argv[2] : nullptr;
+	if (max_n < 1000)
+		max_n = 1000;
+
+	std::printf("\n== ns per element, ours vs std (speedup > 1: ours is faster), %zu elements per case\n", max_n);
+	std::printf("%-14s %-10s %-12s %10s %12s %12s %10s\n", "group", "operation", "type", "n", "ours", "std", "speedup");
+
+	Suite suite{ max_n, {} };
+	run<int>(suite, "int");
+	run<Pod64>(suite, "pod64");
+	run<std::string>(suite, "std::string");
+
+	if (json_path) {
+		Bench::Json_object context;
+#if defined(__clang__)
+		context.add("compiler", "clang " __clang_version__);
+#elif defined(__GNUC__)
+		context.add("compiler", "gcc " __VERSION__);
+#elif defined(_MSC_VER)
+		context.add("compiler", "msvc " + std::to_string(_MSC_VER));
+#endif
+		context.add("cplusplus", static_cast<size_t>(__cplusplus))
+			.add("build_type", BENCH_BUILD_TYPE)
+			.add("cxx_flags", BENCH_CXX_FLAGS)
+			.add("hardware_threads", static_cast<size_t>(std::thread::hardware_concurrency()))
+			.add("max_elements", max_n)
+			.add("seed", static_cast<size_t>(42))
+			.add("timestamp", utc_timestamp());
+
+		if (!Bench::write_json(json_path, context, suite.rows)) {
+			std::fprintf(stderr, "could not write %s\n", json_path);
+			return 1;
+		}
+		std::printf("\nresults written to %s\n", json_path);
+	}
+}
@@ -0,0 +1,76 @@
+// Unrolled_forward_list vs Forward_list: scan, insert-heavy and erase-heavy workloads.
+// Forward_list nodes are allocated interleaved with garbage that is freed afterwards, the way
+// long-running programs scatter nodes across the heap.
+#include "../Forward_list/Forward_list.h"
+#include "../Unrolled_forward_list/Unrolled_forward_list.h"
+#include "Bench.h"
+
+#include <vector>
+#include <memory>
+
+
+template <typename List>
+List build(size_t n) {
+	List list;
+	std::vector<std::unique_ptr<long[]>> garbage;
+	for (size_t i = 0; i < n; ++i) {
+		list.push_front(static_cast<long>(n - i));
+		if (i % 2 == 0)
+			garbage.emplace_back(new long[2 + i % 5]);
+	}
+	return list;
+}
+
+template <typename List>
+void run(const char* name, size_t n) {
+	List list = build<List>(n);
+	char label[64];
+
+	double ms = Bench::best_of(5, [&] {
+		long sum = 0;
+		for (long x : list)
+			sum += x;
+		Bench::do_not_optimize(sum);
+	});
+	std::snprintf(label, sizeof(label), "%s scan", name);
+	Bench::report(label, n, ms);
+
+	ms = Bench::best_of(3, [&] {
+		long hits = 0;
+		for (long v = 0; v < 8; ++v) {
+			for (long x : list)
+				hits += (x % 8 == v);
+		}
+		Bench::do_not_optimize(hits);
+	});
+	std::snprintf(label, sizeof(label), "%s count x8", name);
+	Bench::report(label, 8 * n, ms);
+
+	ms = Bench::time_ms([&] {
+		for (auto it = list.begin(); it != list.end(); ++it)
+			it = list.insert_after(it, -1);
+	});
+	std::snprintf(label, sizeof(label), "%s insert after each", name);
+	Bench::report(label, n, ms);
+
+	ms = Bench::time_ms([&] {
+		for (auto it = list.begin(); it != list.end(); ++it)
+			list.erase_after(it);
+	});
+	std::snprintf(label, sizeof(label), "%s erase after each", name);
+	Bench::report(label, n, ms);
+
+	ms = Bench::time_ms([&] {
+		list.remove_if([](long x) { return x % 3 != 0; });
+	});
+	std::snprintf(label, sizeof(label), "%s remove_if 2/3", name);
+	Bench::report(label, n, ms);
+}
+
+int main() {
+	for (size_t n : { size_t(10000), size_t(1000000), size_t(10000000) }) {
+		Bench::header("long elements");
+		run<Forward_list<long>>("Forward_list", n);
+		run<Unrolled_forward_list<long>>("Unrolled_forward_list", n);
+	}
+}
@@ -6,6 +6,19 @@
 #include <memory>
 #include <iterator>
 #include <functional>
+#include <algorithm>
+#include <exception>
+#include <vector>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+
+#include "../Instrumentation/Container_stats.h"
+
+#if !defined(__GNUC__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 
 
 template <typename T, typename Allocator = std::allocator<T>>
@@ -34,6 +47,12 @@ private:
 		Node(Node<U>* next, Args&&... args) : val(std::forward<Args>(args)...), next(next) {}
 	};
 
+	// radix_sort's default key: the element itself
+	struct Identity_key {
+		template <typename U>
+		const U& operator()(const U& val) const noexcept { return val; }
+	};
+
 
 	template <bool IsConst>
 	struct common_iterator {
@@ -50,16 +69,18 @@ private:
 		std::conditional_t<IsConst, const Node<T>*, Node<T>*> ptr = nullptr;
 
 	public:
+		common_iterator() = default;
+
 		common_iterator(Node<T>* ptr) : ptr(ptr) {}
 
 		template <bool IsOtherConst>
 		common_iterator(common_iterator<IsOtherConst> other) : ptr(other.ptr) {}
 
-		std::conditional_t<IsConst, const T&, T&> operator*() {
+		std::conditional_t<IsConst, const T&, T&> operator*() const {
 			return ptr->val;
 		}
 
-		std::conditional_t<IsConst, const T*, T*> operator->() {
+		std::conditional_t<IsConst, const T*, T*> operator->() const {
 			return &(ptr->val);
 		}
 
@@ -75,12 +96,12 @@ private:
 		}
 
 		template <bool IsOtherConst>
-		bool operator!=(common_iterator<IsOtherConst> other) {
+		bool operator!=(common_iterator<IsOtherConst> other) const {
 			return ptr != other.ptr;
 		}
 
 		template <bool IsOtherConst>
-		bool operator==(common_iterator<IsOtherConst> other) {
+		bool operator==(common_iterator<IsOtherConst> other) const {
 			return ptr == other.ptr;
 		}
 
@@ -90,12 +111,26 @@ public:
 	using iterator			=	common_iterator<false>;
 	using const_iterator	=	common_iterator<true>;
 
+	// Where each part of the list begins, for the traversals taking a Split (for_each, reduce, ... below).
+	// split_into finds the parts with the skip index, which its non-const form builds on first use; a kept Split
+	// saves even that on every later pass. It stays valid while nodes are only inserted, each joining the part
+	// before it, and until a node a part begins at is erased or the existing nodes are relinked (sort, reverse,
+	// merge, splice_after within the list)
+	class Split {
+	public:
+		ND size_type parts() const noexcept { return starts.size(); }
+
+	private:
+		friend class Forward_list;
+		std::vector<Node<T>*> starts;	// starts[0] stands for head, which push_front can change
+	};
+
 	ND iterator begin() noexcept {
 		return iterator(head);
 	}
 
 	ND iterator end() noexcept {
-		return iterator(tail);
+		return iterator(nullptr);
 	}
 
 	ND const_iterator begin() const noexcept {
@@ -103,7 +138,7 @@ public:
 	}
 
 	ND const_iterator end() const noexcept {
-		return const_iterator(tail);
+		return const_iterator(nullptr);
 	}
 
 	ND const_iterator cbegin() const noexcept {
@@ -111,7 +146,7 @@ public:
 	}
 
 	ND const_iterator cend() const noexcept {
-		return const_iterator(tail);
+		return const_iterator(nullptr);
 	}
 
 
@@ -120,8 +155,7 @@ public:
 	explicit Forward_list(const Allocator& alloc) : alloc(alloc) {}
 
 	Forward_list(size_type count, const T& value, const Allocator& alloc = Allocator()): alloc(alloc) {		
-		for (size_t i = 0; i < count; ++i) 
-			push_front(value);
+		insert_after(cbefore_end(), count, value);
 	}
 
 	template <typename U = T, std::enable_if_t<std::is_default_constructible_v<U>, int> = 0>
@@ -131,76 +165,35 @@ public:
     std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category> &&
     !std::is_integral_v<Iterator>, Iterator>* = nullptr>
 	Forward_list(Iterator first, Iterator last, const Allocator& alloc = Allocator()) : alloc(alloc) {
-		if constexpr (std::is_same_v<typename std::iterator_traits<Iterator>::iterator_category, std::bidirectional_iterator_tag> ||	
-					  std::is_same_v<typename std::iterator_traits<Iterator>::iterator_category, std::random_access_iterator_tag>) {	
-			if (last == first)
-				return;
-
-			--last;
-			while (last > first) 
-				push_front(*(last--));
-
-			push_front(*first);
-		}
-		else {
-			while (first != last)
-				push_front(*(first++));
-
-			reverse();
-		}
+		insert_after(cbefore_end(), first, last);
 	}
 
 	Forward_list(const Forward_list& other, const Allocator& alloc) : alloc(alloc) {
-		if (!other.sz)
-			return;
-		
-		auto iter = other.head;
-		push_front(iter->val);
-		iter = iter->next;
-		Node<T>* pre_tail = head;
-
-		while (iter != other.tail) {
-			tail = std::allocator_traits<NodeAlloc>::allocate(this->alloc, 1);
-			std::allocator_traits<NodeAlloc>::construct(this->alloc, tail, nullptr, iter->val);
-
-			pre_tail->next = tail;
-			iter = iter->next;
-			pre_tail = tail;
-			tail = nullptr;
-		}
+		const Node<T>* from = other.head;
+		link_after(nullptr, make_chain(other.sz, [&](Node<T>* p) {
+			std::allocator_traits<NodeAlloc>::construct(this->alloc, p, nullptr, from->val);
+			from = from->next;
+		}), other.sz);
 	} 
 
 	Forward_list(const Forward_list& other) : Forward_list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
 
-	Forward_list(Forward_list&& other, const Allocator& alloc) noexcept {
+	Forward_list(Forward_list&& other, const Allocator& alloc) : alloc(alloc) {
 		if (this->alloc == other.alloc) {
-			std::swap(head, other.head);
-			std::swap(tail, other.tail);
-			std::swap(sz, other.sz);
+			take_nodes(other);
 		}
 		else {
-			Forward_list copied(other, alloc);
-			this->swap(copied);
+			Forward_list moved(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), alloc);
+			take_nodes(moved);
 		}
 	}
 
-	Forward_list(Forward_list&& other) noexcept : Forward_list(std::move(other), std::move(other.get_allocator())) {}										
+	Forward_list(Forward_list&& other) noexcept : alloc(other.alloc) {
+		take_nodes(other);
+	}
 
 	Forward_list(std::initializer_list<T> init, const Allocator& alloc = Allocator()) : alloc(alloc) {
-		auto first = init.begin();
-		auto last = init.end();
-		
-		if (last == first)
-			return;
-
-		--last;
-
-		while (last > first) {
-			push_front(std::move(*last));
-			last--;
-		}
-
-		push_front(std::move(*first));
+		insert_after(cbefore_end(), init.begin(), init.end());
 	}
 
 	~Forward_list() { clear(); }
@@ -210,43 +203,58 @@ public:
 			return *this;
 		
 		if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
-			Forward_list<T> copied(other, other.get_allocator());
-			this->swap(copied);
-			alloc = other.alloc;
-			copied.alloc = NodeAlloc();
-		}
-		else {
-			Forward_list<T> copied(other, get_allocator());
-			this->swap(copied);
+			if (alloc != other.alloc) {
+				clear();
+				alloc = other.alloc;
+			}
 		}
+
+		Forward_list copied(other, get_allocator());
+		clear();
+		take_nodes(copied);
 		
 		return *this;
 	}
 
-	Forward_list& operator=(Forward_list&& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value) {
-		if (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value || alloc == other.alloc) {
-			Forward_list<T> copied(std::move(other), other.get_allocator());
-			this->swap(copied);
+	Forward_list& operator=(Forward_list&& other) noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+														   std::allocator_traits<Allocator>::is_always_equal::value) {
+		if (this == &other)
+			return *this;
+
+		clear();
+		if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
 			alloc = other.alloc;
-			copied.alloc = NodeAlloc();
+			take_nodes(other);
+		}
+		else if (alloc == other.alloc) {
+			take_nodes(other);
 		}
 		else {
-			Forward_list<T> copied(std::move(other));
-			this->swap(copied);
-
-			alloc = other.alloc;
+			Forward_list moved(std::move(other), get_allocator());
+			take_nodes(moved);
 		}
 		return *this;
 	}
 
 	Forward_list& operator=(std::initializer_list<T> ilist) {
-		Forward_list copied(ilist, alloc);
-		this->swap(copied);
+		Forward_list copied(ilist, get_allocator());
+		clear();
+		take_nodes(copied);
 
 		return *this;
 	}
 
-	constexpr allocator_type get_allocator() const { return Allocator(); }
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+
+	// Allocation counts need a Counting_allocator, operation counts need CONTAINER_STATS (Instrumentation/Container_stats.h)
+	ND Container_stats stats() const {
+		Container_stats s;
+		stats_detail::add_allocations(s, alloc);
+#ifdef CONTAINER_STATS
+		stats_detail::add_operations(s, op_stats);
+#endif
+		return s;
+	}
 
 
 	// Element access
@@ -255,6 +263,10 @@ public:
 
 	ND const_reference front() const noexcept { return head->val; }
 
+	ND reference back() noexcept { return tail->val; }
+
+	ND const_reference back() const noexcept { return tail->val; }
+
 
 	// Capacity
 
@@ -266,7 +278,13 @@ public:
 	// Modifiers
 
 	void clear() {
-		while (sz) pop_front();
+		drop_index();
+		if (!discard_storage())
+			free_nodes(head);
+
+		head = tail = nullptr;
+		sz = 0;
+		release_storage();
 	}
 
 	void push_front(const T& val) {
@@ -278,32 +296,88 @@ public:
 	}
 
 	void pop_front() {
+		CONTAINER_STATS_COUNT(pops, 1);
+		drop_index();
 		auto new_head = head->next;
 
 		std::allocator_traits<NodeAlloc>::destroy(alloc, head);
 		std::allocator_traits<NodeAlloc>::deallocate(alloc, head, 1);
 
 		head = new_head;
+		if (!head)
+			tail = nullptr;
 		--sz;
 	}
 
 	template <class... Args>
 	reference emplace_front(Args&&... args) { 
+		CONTAINER_STATS_COUNT(pushes, 1);
 		auto p = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
 		std::allocator_traits<NodeAlloc>::construct(alloc, p, head, std::forward<Args>(args)...);
-		
+		drop_index();
+
+		if (!head)
+			tail = p;
 		++sz;
 		head = p;
 		return head->val;
 	}
 
+	void push_back(const T& val) {
+		emplace_back(val);
+	}
+
+	void push_back(T&& val) {
+		emplace_back(std::move(val));
+	}
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		CONTAINER_STATS_COUNT(pushes, 1);
+		auto p = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
+		try {
+			std::allocator_traits<NodeAlloc>::construct(alloc, p, nullptr, std::forward<Args>(args)...);
+		}
+		catch (...) {
+			std::allocator_traits<NodeAlloc>::deallocate(alloc, p, 1);
+			throw;
+		}
+
+		if (tail)
+			tail->next = p;
+		else
+			head = p;
+		tail = p;
+		++sz;
+		return p->val;
+	}
+
+	// Moves every node of other to the end of this list in O(1). The allocators must compare equal
+	void append(Forward_list&& other) noexcept {
+		if (this == &other || !other.head)
+			return;
+
+		CONTAINER_STATS_COUNT(splices, 1);
+		other.drop_index();
+		if (tail)
+			tail->next = other.head;
+		else
+			head = other.head;
+		tail = other.tail;
+		sz += other.sz;
+
+		other.head = other.tail = nullptr;
+		other.sz = 0;
+	}
+
 	void swap(Forward_list& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value) {
-		if (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+		if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
 			std::swap(alloc, other.alloc);
 			
 		std::swap(sz, other.sz);
 		std::swap(head, other.head);
 		std::swap(tail, other.tail);
+		std::swap(skip, other.skip);
 	}
 
 	iterator insert_after(const_iterator pos, const T& value) {
@@ -315,51 +389,47 @@ public:
 	}
 
 	iterator insert_after( const_iterator pos, size_type count, const T& value ) {
-		if (count == 0) return iterator(const_cast<Node<T>*>(pos.ptr));
 		Node<T>* pointer_to_pos = const_cast<Node<T>*>(pos.ptr);
-		Node<T>* next_to_pos = pointer_to_pos->next;
-
-		Node<T>* new_nodes_first = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
-		std::allocator_traits<NodeAlloc>::construct(alloc, new_nodes_first, nullptr, value);
-		Node<T>* new_nodes_last = new_nodes_first;
-
-		for (size_t i = 1; i < count; ++i) {
-			Node<T>* new_node = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
-			std::allocator_traits<NodeAlloc>::construct(alloc, new_node, nullptr, value);
-			new_nodes_last->next = new_node;
-			new_nodes_last = new_node;
-		}
-
-		pointer_to_pos->next = new_nodes_first;
-		new_nodes_last->next = next_to_pos;
-		sz += count;
-		return iterator(new_nodes_last);
+		if (count == 0) return iterator(pointer_to_pos);
+
+		CONTAINER_STATS_COUNT(inserts, count);
+		auto chain = make_chain(count, [&](Node<T>* p) {
+			std::allocator_traits<NodeAlloc>::construct(alloc, p, nullptr, value);
+		});
+		link_after(pointer_to_pos, chain, count);
+		return iterator(chain.second);
 	}
 
+	// Forward iterator ranges are counted first so the nodes come from a single allocation where the allocator allows it
 	template<class InputIt, typename std::enable_if<
     std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value &&
     !std::is_integral<InputIt>::value, InputIt>::type* = nullptr>
 	iterator insert_after(const_iterator pos, InputIt first, InputIt last) {
 		Node<T>* pointer_to_pos = const_cast<Node<T>*>(pos.ptr);
 		if (first == last) return iterator(pointer_to_pos);
-		Node<T>* next_to_pos = pointer_to_pos->next;
-
-		Node<T>* new_nodes_first = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
-		std::allocator_traits<NodeAlloc>::construct(alloc, new_nodes_first, nullptr, *(first++));
-		Node<T>* new_nodes_last = new_nodes_first;
-		++sz;
 
-		while (first != last) {
-			Node<T>* new_node = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
-			std::allocator_traits<NodeAlloc>::construct(alloc, new_node, nullptr, *(first++));
-			new_nodes_last->next = new_node;
-			new_nodes_last = new_node;
-			++sz;
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>) {
+			size_type count = static_cast<size_type>(std::distance(first, last));
+			CONTAINER_STATS_COUNT(inserts, count);
+			auto chain = make_chain(count, [&](Node<T>* p) {
+				std::allocator_traits<NodeAlloc>::construct(alloc, p, nullptr, *first);
+				++first;
+			});
+			link_after(pointer_to_pos, chain, count);
+			return iterator(chain.second);
+		}
+		else {
+			Forward_list read(get_allocator());
+			for (; first != last; ++first)
+				read.emplace_back(*first);
+
+			CONTAINER_STATS_COUNT(inserts, read.sz);
+			Node<T>* read_last = read.tail;
+			link_after(pointer_to_pos, { read.head, read.tail }, read.sz);
+			read.head = read.tail = nullptr;
+			read.sz = 0;
+			return iterator(read_last);
 		}
-
-		pointer_to_pos->next = new_nodes_first;
-		new_nodes_last->next = next_to_pos;
-		return iterator(new_nodes_last);
 	}
 
 	iterator insert_after(const_iterator pos, std::initializer_list<T> ilist) {
@@ -371,9 +441,14 @@ public:
 		Node<T>* pointer_to_pos = const_cast<Node<T>*>(pos.ptr);
 		Node<T>* next_to_pos = pointer_to_pos->next;
 
+		CONTAINER_STATS_COUNT(inserts, 1);
 		Node<T>* new_node = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
 		std::allocator_traits<NodeAlloc>::construct(alloc, new_node, next_to_pos, std::forward<Args>(args)...);
 		pointer_to_pos->next = new_node;
+		if (pointer_to_pos == tail)
+			tail = new_node;
+		else
+			drop_index();
 		++sz;
 
 		return iterator(new_node);
@@ -382,17 +457,22 @@ public:
 	iterator erase_after(const_iterator pos) {
 		Node<T>* pointer_to_pos = const_cast<Node<T>*>(pos.ptr);
 		if (pointer_to_pos->next == nullptr) return iterator(nullptr);
+		CONTAINER_STATS_COUNT(erases, 1);
+		drop_index();
 		Node<T>* next_to_pos = pointer_to_pos->next;
 		pointer_to_pos->next = next_to_pos->next;
+		if (next_to_pos == tail)
+			tail = pointer_to_pos;
 
 		std::allocator_traits<NodeAlloc>::destroy(alloc, next_to_pos);
 		std::allocator_traits<NodeAlloc>::deallocate(alloc, next_to_pos, 1);
 		--sz;
-		return iterator(next_to_pos);
+		return iterator(pointer_to_pos->next);
 	}
 
 	iterator erase_after(const_iterator first, const_iterator last) {
 		if (first == last) return iterator(const_cast<Node<T>*>(last.ptr));
+		drop_index();
 		Node<T>* pointer_to_last = const_cast<Node<T>*>(last.ptr);
 		Node<T>* pointer_to_first = const_cast<Node<T>*>(first.ptr);
 		Node<T>* to_erase = pointer_to_first->next;
@@ -403,9 +483,12 @@ public:
 			std::allocator_traits<NodeAlloc>::deallocate(alloc, to_erase, 1);
 			to_erase = next_to_erase;
 			--sz;
+			CONTAINER_STATS_COUNT(erases, 1);
 		}
 
 		pointer_to_first->next = pointer_to_last;
+		if (!pointer_to_last)
+			tail = pointer_to_first;
 		return iterator(pointer_to_last);
 	}
 
@@ -415,11 +498,20 @@ public:
 	}
 
 	void resize( size_type count, const T& value ) {
-		if (count == sz) return;
-		while (sz > count)
-			pop_front();
+		if (count == 0) {
+			clear();
+			return;
+		}
+
+		if (count < sz) {
+			Node<T>* last = head;
+			for (size_type i = 1; i < count; ++i)
+				last = last->next;
+			erase_after(const_iterator(last), cend());
+		}
+
 		while (sz < count)
-			push_front(value);
+			emplace_back(value);
 	}
 
 	// Operations
@@ -428,24 +520,35 @@ public:
 		return count;
 	}
 
-	template <typename UnaryPredicate>
+	// Prefetch = true requests the next node before p runs on the current one, so the cache miss overlaps
+	// with p. It pays off when p does real work; a cheap p leaves the scan bound by the pointer chasing
+	template <bool Prefetch = false, typename UnaryPredicate>
 	size_type remove_if(UnaryPredicate p) {
+		drop_index();
 		size_t removed = 0;
 		while (head && p(head->val)) {
-			pop_front();
+			Node<T>* next = head->next;
+			free_node(head);
+			head = next;
+			--sz;
 			++removed;
 		}
 
-		if (!sz) return 0;
+		if (!head) {
+			tail = nullptr;
+			CONTAINER_STATS_COUNT(erases, removed);
+			return removed;
+		}
 		Node<T>* left = head;
 		Node<T>* right = head->next;
 
 		while (right) {
+			if constexpr (Prefetch)
+				prefetch(right->next);
+
 			if (p(right->val)) {
 				left->next = right->next;
-
-				std::allocator_traits<NodeAlloc>::destroy(alloc, right);
-				std::allocator_traits<NodeAlloc>::deallocate(alloc, right, 1);
+				free_node(right);
 				--sz;
 
 				++removed;
@@ -457,15 +560,61 @@ public:
 			}
 		}
 
+		tail = left;
+		CONTAINER_STATS_COUNT(erases, removed);
+		return removed;
+	}
+
+	// Moves every element for which p is true, in order, into the returned list without destroying or reallocating
+	// anything during the scan: the nodes can be filtered further, spliced back, or dropped together later.
+	// The result shares this list's allocator, so with a pooling allocator dropped nodes go back to the same pool.
+	// Prefetch as for remove_if.
+	// If p throws, the elements extracted so far are destroyed and the rest of the list is left as it was
+	template <bool Prefetch = false, typename UnaryPredicate>
+	Forward_list extract_if(UnaryPredicate p) {
+		drop_index();
+		Forward_list removed(get_allocator());
+		Node<T>* prev = nullptr;
+		Node<T>* cur = head;
+
+		while (cur) {
+			Node<T>* next = cur->next;
+			if constexpr (Prefetch)
+				prefetch(next);
+
+			if (p(cur->val)) {
+				if (prev)
+					prev->next = next;
+				else
+					head = next;
+				if (!next)
+					tail = prev;
+				--sz;
+
+				cur->next = nullptr;
+				if (removed.tail)
+					removed.tail->next = cur;
+				else
+					removed.head = cur;
+				removed.tail = cur;
+				++removed.sz;
+			}
+			else
+				prev = cur;
+			cur = next;
+		}
+
+		CONTAINER_STATS_COUNT(erases, removed.sz);
 		return removed;
 	}
 
 	void reverse() {
 		if (!sz) return;
+		drop_index();
 
 		Node<T>* left = nullptr;
 		Node<T>* right = head;
-		tail = left;
+		tail = head;
 
 		while (right) {
 			auto next_to_right = right->next;
@@ -482,6 +631,7 @@ public:
 		if (sz <= 1)
 			return 0;
 
+		drop_index();
 		size_type count = 0;
 		Node<T>* cur = head, * next = head->next;
 
@@ -501,36 +651,87 @@ public:
 			}
 		}
 
+		tail = cur;
+		CONTAINER_STATS_COUNT(erases, count);
 		return count;
 	}
 
+	// Removes every element equal to an earlier one, wherever it is, in one pass: the first occurrence of each value
+	// stays and the order is kept. Nodes seen so far are recorded in an open-addressing table of about 1.5 * size()
+	// slots (16 bytes each) taken from the list's allocator and returned before dedup returns.
+	// Returns the number of elements removed
+	template <typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+	size_type dedup(Hash hash = Hash(), KeyEqual equal = KeyEqual()) {
+		if (sz <= 1)
+			return 0;
+
+		drop_index();
+		Seen_table seen(alloc, sz + sz / 2);
+		size_type count = 0;
+		Node<T>* prev = nullptr;
+		Node<T>* cur = head;
+
+		while (cur) {
+			size_t h = hash(cur->val);
+			Seen_slot* slot = seen.find(h, [&](const Node<T>* node) { return equal(node->val, cur->val); });
+
+			if (slot->node) {
+				prev->next = cur->next;
+				std::allocator_traits<NodeAlloc>::destroy(alloc, cur);
+				std::allocator_traits<NodeAlloc>::deallocate(alloc, cur, 1);
+				cur = prev->next;
+				++count;
+				--sz;
+			}
+			else {
+				*slot = { h, cur };
+				prev = cur;
+				cur = cur->next;
+			}
+		}
+
+		tail = prev;
+		CONTAINER_STATS_COUNT(erases, count);
+		return count;
+	}
+
+	// O(1): other's last node is known
 	void splice_after(const_iterator pos, Forward_list& other) {
-		if (other.empty()) return;
+		if (this == &other || other.empty()) return;
+		CONTAINER_STATS_COUNT(splices, 1);
+		drop_index();
+		other.drop_index();
 
-		Node<T>* before_other_end = other.begin().ptr;
-		while (before_other_end->next != nullptr)
-			before_other_end = before_other_end->next;
-		
 		Node<T>* pointer_to_pos = const_cast<Node<T>*>(pos.ptr);
 		Node<T>* next_to_pos = pointer_to_pos->next;
 
-		pointer_to_pos->next = other.begin().ptr;
-		before_other_end->next = next_to_pos;
+		pointer_to_pos->next = other.head;
+		other.tail->next = next_to_pos;
+		if (pointer_to_pos == tail)
+			tail = other.tail;
 
-		other.head = nullptr;
-		other.sz = 0;
 		sz += other.sz;
+		other.head = other.tail = nullptr;
+		other.sz = 0;
 	}
 
 	void splice_after(const_iterator pos, Forward_list& other, const_iterator it) {
 		Node<T>* pointer_to_it = const_cast<Node<T>*>(it.ptr);
 		Node<T>* pointer_to_pos = const_cast<Node<T>*>(pos.ptr);
 		Node<T>* next_to_it = pointer_to_it->next;
+		if (pointer_to_pos == pointer_to_it || pointer_to_pos == next_to_it) return;
+		CONTAINER_STATS_COUNT(splices, 1);
+		drop_index();
+		other.drop_index();
 		Node<T>* next_to_pos = pointer_to_pos->next;
 		
 		pointer_to_it->next = next_to_it->next;
+		if (next_to_it == other.tail)
+			other.tail = pointer_to_it;
 		pointer_to_pos->next = next_to_it;
 		next_to_it->next = next_to_pos;
+		if (pointer_to_pos == tail)
+			tail = next_to_it;
 		++sz;
 		--other.sz;
 	}
@@ -549,6 +750,9 @@ public:
 		}
 
 		if (count == 0) return;
+		CONTAINER_STATS_COUNT(splices, 1);
+		drop_index();
+		other.drop_index();
 		sz += count;
     	other.sz -= count;
 
@@ -558,99 +762,1285 @@ public:
 		pointer_to_pos->next = pointer_to_other_first->next;
 		before_other_last->next = next_to_pos;
 		pointer_to_other_first->next = pointer_to_other_last;
+		if (before_other_last == other.tail)
+			other.tail = pointer_to_other_first;
+		if (pointer_to_pos == tail)
+			tail = before_other_last;
 	}
 
 
 	template <typename Compare = std::less<T>>
-	void merge(Forward_list<T, Allocator>& other) {
+	void merge(Forward_list<T, Allocator>& other, Compare comp = Compare()) {
 		if (this == &other || other.head == nullptr) return;
 
-		Node<T>* left = this->head;
-		Node<T>* right = other.head;
-		this->sz += other.sz;
+		CONTAINER_STATS_COUNT(merges, 1);
+		CONTAINER_STATS_TIME(merge_ns);
+		drop_index();
+		other.drop_index();
+		// On ties this list's nodes go first, so other's last node ends up last unless it is strictly smaller
+		Node<T>* new_tail = tail && comp(other.tail->val, tail->val) ? tail : other.tail;
+		head = merge_chains(head, other.head, comp);
+		tail = new_tail;
+		sz += other.sz;
+
+		other.head = other.tail = nullptr;
 		other.sz = 0;
+	}
+
+	template <typename Compare = std::less<T>>
+	void merge(Forward_list<T, Allocator>&& other, Compare comp = Compare()) {
+		merge(other, comp);
+	}
+
+	// Merges every list in `lists` (a range of Forward_lists) into this one with a loser tree: O(n log k) for
+	// k lists, where repeated merge calls cost up to O(n k). All of them must be sorted by comp and have
+	// allocators equal to this one's; they are left empty. Nodes are only relinked, never copied.
+	// Stable: on ties this list's elements come first, then the lists' in range order.
+	// If comp throws, every node ends up in this list, in unspecified order
+	template <typename Range, typename Compare = std::less<T>>
+	void merge_all(Range&& lists, Compare comp = Compare()) {
+		std::vector<Node<T>*> chains, tails;
+		if (head) {
+			chains.push_back(head);
+			tails.push_back(tail);
+		}
+		size_type total = sz;
+		for (Forward_list& other : lists) {
+			if (&other == this || !other.head)
+				continue;
+			chains.push_back(other.head);
+			tails.push_back(other.tail);
+			total += other.sz;
+			other.drop_index();
+			other.head = other.tail = nullptr;
+			other.sz = 0;
+		}
 
-		if (head == nullptr) {
-			head = right;
-			right = nullptr;
+		size_t k = chains.size();
+		if (k == 0)
 			return;
+		drop_index();
+
+		CONTAINER_STATS_COUNT(merges, 1);
+		CONTAINER_STATS_TIME(merge_ns);
+
+		Node<T>* first = nullptr;
+		Node<T>** link = &first;
+		try {
+			size_t w = k == 1 ? 0 : merge_tree(chains, link, comp);
+			*link = chains[w];
+			tail = tails[w];
 		}
+		catch (...) {
+			// Every node is either linked from first or still in its chain
+			for (size_t i = 0; i < k; ++i) {
+				if (chains[i]) {
+					*link = chains[i];
+					link = &tails[i]->next;
+					tail = tails[i];
+				}
+			}
+			head = first;
+			sz = total;
+			throw;
+		}
+
+		head = first;
+		sz = total;
+	}
+	
+private:
+
+	template <typename A, typename = void>
+	struct has_release : std::false_type {};
+
+	template <typename A>
+	struct has_release<A, std::void_t<decltype(std::declval<A&>().release())>> : std::true_type {};
+
+	template <typename A, typename = void>
+	struct has_discard : std::false_type {};
+
+	template <typename A>
+	struct has_discard<A, std::void_t<decltype(std::declval<A&>().discard()), decltype(std::declval<const A&>().live_blocks())>> : std::true_type {};
 
-		Compare comp;
-		if (comp(right->val, head->val)) {
-			Node<T>* great = right;
-			while (great->next && comp(great->next->val, head->val))
-				great = great->next;
+	template <typename A, typename = void>
+	struct has_allocate_blocks : std::false_type {};
 
-			Node<T>* next_to_great = great->next;
-			great->next = head;
-			head = right;
-			right = next_to_great;
+	template <typename A>
+	struct has_allocate_blocks<A, std::void_t<decltype(std::declval<A&>().allocate_blocks(size_type()))>> : std::true_type {};
+
+	// Pooling allocators (see Allocators/Pool_allocator.h) get their slabs back once the list is empty
+	void release_storage() noexcept {
+		if constexpr (has_release<NodeAlloc>::value)
+			alloc.release();
+	}
+
+	// Drops the whole node pool at once when this list owns every node in it and no destructor has to run
+	bool discard_storage() noexcept {
+		if constexpr (std::is_trivially_destructible_v<T> && has_discard<NodeAlloc>::value) {
+			if (alloc.live_blocks() == sz) {
+				alloc.discard();
+				return true;
+			}
 		}
+		return false;
+	}
 
-		while (left && right && left->next) {
-			if (comp(left->next->val, right->val)) { 
-				left = left->next;
+	// Hint to start loading the node at p, nullptr allowed
+	static void prefetch(const void* p) noexcept {
+#if defined(__GNUC__)
+		__builtin_prefetch(p);
+#elif defined(_M_X64) || defined(_M_IX86)
+		_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#endif
+	}
+
+	struct Seen_slot {
+		size_t hash;
+		const Node<T>* node;
+	};
+
+	// Fixed-size linear-probing set of nodes for dedup, drawn from the list's allocator. Never fills up:
+	// it has more slots than the list has nodes
+	struct Seen_table {
+		using Slot_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Seen_slot>;
+
+		Slot_alloc alloc;
+		Seen_slot* slots;
+		size_t mask;
+		unsigned shift;
+
+		template <typename A>
+		Seen_table(const A& list_alloc, size_t min_slots) : alloc(list_alloc) {
+			size_t cap = 16;
+			shift = 60;
+			while (cap < min_slots) {
+				cap <<= 1;
+				--shift;
+			}
+
+			mask = cap - 1;
+			slots = std::allocator_traits<Slot_alloc>::allocate(alloc, cap);
+			for (size_t i = 0; i < cap; ++i)
+				slots[i] = { 0, nullptr };
+		}
+
+		Seen_table(const Seen_table&) = delete;
+		Seen_table& operator=(const Seen_table&) = delete;
+
+		~Seen_table() {
+			std::allocator_traits<Slot_alloc>::deallocate(alloc, slots, mask + 1);
+		}
+
+		// The slot holding a node for which same(node) is true, or the empty slot where it would go.
+		// The hash is scrambled first so identity hashes of sequential keys do not pile up in one run
+		template <typename Same>
+		Seen_slot* find(size_t hash, Same&& same) {
+			size_t i = static_cast<size_t>((static_cast<unsigned long long>(hash) * 0x9E3779B97F4A7C15ull) >> shift) & mask;
+			while (slots[i].node && (slots[i].hash != hash || !same(slots[i].node)))
+				i = (i + 1) & mask;
+			return &slots[i];
+		}
+	};
+
+	// Position after which the constructors append: the last node, or nullptr while the list is empty
+	const_iterator cbefore_end() const noexcept {
+		return const_iterator(tail);
+	}
+
+	// Builds n nodes linked in order, make(p) constructing the node at p with a null next.
+	// The nodes are one contiguous run when the allocator offers allocate_blocks (see Allocators/Pool_allocator.h)
+	// and are still freed one by one. If make throws, every node is given back and the exception propagates
+	template <typename Make>
+	std::pair<Node<T>*, Node<T>*> make_chain(size_type n, Make&& make) {
+		Node<T>* first = nullptr;
+		Node<T>* last = nullptr;
+		if (n == 0)
+			return { first, last };
+
+		Node<T>* block = nullptr;
+		if constexpr (has_allocate_blocks<NodeAlloc>::value)
+			block = alloc.allocate_blocks(n);
+
+		size_type built = 0;
+		try {
+			for (; built < n; ++built) {
+				Node<T>* p = block ? block + built : std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
+				try {
+					make(p);
+				}
+				catch (...) {
+					if (!block)
+						std::allocator_traits<NodeAlloc>::deallocate(alloc, p, 1);
+					throw;
+				}
+
+				if (last)
+					last->next = p;
+				else
+					first = p;
+				last = p;
+			}
+		}
+		catch (...) {
+			free_nodes(first);
+			for (; block && built < n; ++built)
+				std::allocator_traits<NodeAlloc>::deallocate(alloc, block + built, 1);
+			throw;
+		}
+
+		return { first, last };
+	}
+
+	// Links a chain of n nodes in after pos, or at the front when pos is nullptr (only used on an empty list)
+	void link_after(Node<T>* pos, std::pair<Node<T>*, Node<T>*> chain, size_type n) noexcept {
+		if (!chain.first)
+			return;
+
+		if (pos) {
+			chain.second->next = pos->next;
+			pos->next = chain.first;
+		}
+		else {
+			chain.second->next = head;
+			head = chain.first;
+		}
+
+		if (pos == tail)
+			tail = chain.second;
+		else
+			drop_index();
+		sz += n;
+	}
+
+	// Moves other's nodes into this empty list. The allocators must compare equal
+	void take_nodes(Forward_list& other) noexcept {
+		head = std::exchange(other.head, nullptr);
+		tail = std::exchange(other.tail, nullptr);
+		sz = std::exchange(other.sz, 0);
+		skip = std::move(other.skip);
+	}
+
+	// Re-reads the last node after the nodes were relinked wholesale
+	void find_tail() noexcept {
+		tail = head;
+		if (tail) {
+			while (tail->next)
+				tail = tail->next;
+		}
+	}
+
+	// Destroys and deallocates one node its caller has already unlinked; counting the erase is up to the caller
+	void free_node(Node<T>* n) noexcept {
+		std::allocator_traits<NodeAlloc>::destroy(alloc, n);
+		std::allocator_traits<NodeAlloc>::deallocate(alloc, n, 1);
+	}
+
+	// Destroys and deallocates a null-terminated chain, skipping the destructor calls for trivially destructible T
+	void free_nodes(Node<T>* first) noexcept {
+		while (first) {
+			Node<T>* next = first->next;
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				std::allocator_traits<NodeAlloc>::destroy(alloc, first);
+			std::allocator_traits<NodeAlloc>::deallocate(alloc, first, 1);
+			first = next;
+		}
+	}
+
+	// Every stride-th node of the list, see build_index. The index and its marks come from the list's allocator
+	struct Skip_index {
+		using Marks_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Node<T>*>;
+
+		std::vector<Node<T>*, Marks_alloc> marks;	// marks[i] is the node at position i * stride, empty while dropped
+		size_type stride = 0;
+
+		template <typename A>
+		explicit Skip_index(const A& list_alloc) : marks(Marks_alloc(list_alloc)) {}
+	};
+
+	// Frees the skip index through the allocator its marks keep, the one it was drawn from, so it stays right
+	// when a move or swap hands the index to another list
+	struct Skip_deleter {
+		using Index_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Skip_index>;
+
+		void operator()(Skip_index* s) const noexcept {
+			Index_alloc alloc(s->marks.get_allocator());
+			std::allocator_traits<Index_alloc>::destroy(alloc, s);
+			std::allocator_traits<Index_alloc>::deallocate(alloc, s, 1);
+		}
+	};
+
+	// An empty skip index with the given stride, drawn from the list's allocator
+	void new_index(size_type stride) {
+		typename Skip_deleter::Index_alloc index_alloc(alloc);
+		Skip_index* s = std::allocator_traits<typename Skip_deleter::Index_alloc>::allocate(index_alloc, 1);
+		std::allocator_traits<typename Skip_deleter::Index_alloc>::construct(index_alloc, s, alloc);
+		s->stride = stride;
+		skip.reset(s);
+	}
+
+	// Forgets the marks after a change that moved nodes or shifted positions, keeping their storage
+	void drop_index() noexcept {
+		if (skip)
+			skip->marks.clear();
+	}
+
+	// The skip index, built first if it was dropped, or extended to the nodes appended since its last use.
+	// Only non-const members build it, so const ones can run concurrently; they read it through seek instead
+	const Skip_index& index() {
+		if (!skip)
+			new_index(skip_stride);
+
+		Skip_index& s = *skip;
+		if (s.marks.empty() && head)
+			s.marks.push_back(head);
+		if (s.marks.size() * s.stride < sz) {
+			Node<T>* cur = s.marks.back();
+			size_type pos = (s.marks.size() - 1) * s.stride;
+			for (size_type mark = pos + s.stride; mark < sz; mark += s.stride) {
+				for (; pos < mark; ++pos)
+					cur = cur->next;
+				s.marks.push_back(cur);
+			}
+		}
+		return s;
+	}
+
+	// Node at position n < size(), walking from node `from` at position pos <= n or from the last mark of s
+	// at or before n, whichever is closer. s may be null or dropped, or miss nodes appended since it was built
+	Node<T>* seek(const Skip_index* s, Node<T>* from, size_type pos, size_type n) const noexcept {
+		if (s && !s->marks.empty()) {
+			size_type m = std::min<size_type>(n / s->stride, s->marks.size() - 1);
+			if (m * s->stride > pos) {
+				from = s->marks[m];
+				pos = m * s->stride;
+			}
+		}
+		for (; pos < n; ++pos)
+			from = from->next;
+		return from;
+	}
+
+	// Node at position n < size(), fewer than stride steps from a mark
+	Node<T>* node_at(size_type n) {
+		return seek(&index(), head, 0, n);
+	}
+
+	Node<T>* node_at(size_type n) const {
+		return seek(skip.get(), head, 0, n);
+	}
+
+	// First node for which before(element) is false, on a list where those for which it is true all come first:
+	// a binary search over the marks, then a walk from the last mark still before, at most stride steps once
+	// the index covers the whole list. Without marks it is a walk from head
+	template <typename Before>
+	Node<T>* partition_node(Before&& before) {
+		return partition_node(&index(), before);
+	}
+
+	template <typename Before>
+	Node<T>* partition_node(Before&& before) const {
+		return partition_node(skip.get(), before);
+	}
+
+	template <typename Before>
+	Node<T>* partition_node(const Skip_index* s, Before& before) const {
+		if (!sz)
+			return nullptr;
+		if (!s || s->marks.empty()) {
+			Node<T>* node = head;
+			while (node && before(std::as_const(node->val)))
+				node = node->next;
+			return node;
+		}
+
+		const auto& marks = s->marks;
+		size_t lo = 0, hi = marks.size();
+		while (lo < hi) {
+			size_t mid = lo + (hi - lo) / 2;
+			if (before(std::as_const(marks[mid]->val)))
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (lo == 0)
+			return head;
+
+		Node<T>* node = marks[lo - 1];
+		while (node && before(std::as_const(node->val)))
+			node = node->next;
+		return node;
+	}
+
+	// Merges two sorted null-terminated chains by relinking. On ties nodes of `left` go first
+	template <typename Compare>
+	static Node<T>* merge_chains(Node<T>* left, Node<T>* right, Compare& comp) {
+		Node<T>* first = nullptr;
+		Node<T>** link = &first;
+
+		while (left && right) {
+			if (comp(right->val, left->val)) {
+				*link = right;
+				right = right->next;
 			}
 			else {
-				Node<T>* next_to_right = right->next;
-				Node<T>* next_to_left = left->next;
+				*link = left;
+				left = left->next;
+			}
+			link = &(*link)->next;
+		}
 
-				left->next = right;
-				right->next = next_to_left;
-				right = next_to_right;
+		*link = left ? left : right;
+		return first;
+	}
+
+	// Loser tree over the heads of k >= 2 non-empty chains, for merge_all. Appends nodes to link in order until only
+	// one chain is left, whose index it returns; chains[i] always points at the rest of chain i. Each node after
+	// the first costs about log2(k) comparisons. Ties go to the lower index, so the merge is stable, and an
+	// exhausted chain loses to everything
+	template <typename Compare>
+	static size_t merge_tree(std::vector<Node<T>*>& chains, Node<T>**& link, Compare& comp) {
+		size_t k = chains.size();
+		if (k == 2)
+			return merge_pair(chains, link, comp);
+
+		// a's head goes before b's
+		auto beats = [&chains, &comp](size_t a, size_t b) {
+			return a < b ? !comp(chains[b]->val, chains[a]->val) : comp(chains[a]->val, chains[b]->val);
+		};
+
+		// Internal node n has children 2n and 2n + 1; leaf i sits at k + i. losers[n] is the chain that lost at n
+		std::vector<size_t> losers(k);
+		size_t w;
+		{
+			std::vector<size_t> winners(2 * k);
+			for (size_t i = 0; i < k; ++i)
+				winners[k + i] = i;
+			for (size_t n = k - 1; n > 0; --n) {
+				size_t a = winners[2 * n], b = winners[2 * n + 1];
+				bool a_wins = beats(a, b);
+				winners[n] = a_wins ? a : b;
+				losers[n] = a_wins ? b : a;
 			}
+			w = winners[1];
 		}
 
-		left->next = right;
+		size_t live = k;
+		Node<T>* head_w = chains[w];
+		while (live > 1) {
+			*link = head_w;
+			link = &head_w->next;
+			head_w = head_w->next;
+			chains[w] = head_w;
+			if (head_w)
+				prefetch(head_w->next);	// needed when w wins again, usually some k nodes later
+			else
+				--live;
+
+			// Replay w's path to the root: whoever beats it there stays winner on the way up
+			for (size_t n = (w + k) / 2; n > 0; n /= 2) {
+				size_t l = losers[n];
+				Node<T>* head_l = chains[l];
+				if (head_l && (!head_w || (l < w ? !comp(head_w->val, head_l->val) : comp(head_l->val, head_w->val)))) {
+					losers[n] = w;
+					w = l;
+					head_w = head_l;
+				}
+			}
+		}
+		return w;
 	}
-	
-private:
 
-	template <typename _Iter, typename Compare>
-	void merge_sort(_Iter begin, _Iter end, const Compare& comp) {
-		size_t dist = std::distance(begin, end);
-		if (dist <= 1) return;
+	// merge_tree for two chains: a plain merge, cheaper than the tree. Writes its progress back if comp throws
+	template <typename Compare>
+	static size_t merge_pair(std::vector<Node<T>*>& chains, Node<T>**& link, Compare& comp) {
+		Node<T>* left = chains[0];
+		Node<T>* right = chains[1];
+		Node<T>** out = link;
+
+		try {
+			while (left && right) {
+				if (comp(right->val, left->val)) {
+					*out = right;
+					right = right->next;
+				}
+				else {
+					*out = left;
+					left = left->next;
+				}
+				out = &(*out)->next;
+			}
+		}
+		catch (...) {
+			chains[0] = left;
+			chains[1] = right;
+			link = out;
+			throw;
+		}
 
-		_Iter mid = std::next(begin, dist / 2); 
-	
-		merge_sort(begin, mid, comp); // [b, m)
-		merge_sort(mid, end, comp); // [m, e)
+		chains[0] = left;
+		chains[1] = right;
+		link = out;
+		return left ? 0 : 1;
+	}
 
-		T* buffer = new T[dist];
-		size_t ind = 0;
-		_Iter left = begin;
-		_Iter right = mid;
+	// Number of interleaved walks in a radix_sort pass
+	static constexpr size_t radix_streams = 8;
 
-		while (left != mid && right != end) {
-			if (comp(*left, *right)) buffer[ind] = std::move(*(left++));
-			else buffer[ind] = std::move(*(right++));
-			ind++;
+	// radix_sort's bucket chains, in list order; counts are per digit
+	struct Radix_chains {
+		static constexpr size_t size = 256 * radix_streams;
+
+		Node<T>* heads[size];
+		Node<T>* tails[size];
+		size_t counts[256];
+
+		void clear() noexcept {
+			std::fill(std::begin(heads), std::end(heads), nullptr);
+			std::fill(std::begin(counts), std::end(counts), size_t(0));
 		}
 
-		while (left != mid)
-			buffer[ind++] = std::move(*(left++));
-		while (right != end)
-			buffer[ind++] = std::move(*(right++));
+		// Links first .. last_of_chain after last; the tail's next is left to the caller
+		static void append(Node<T>*& head, Node<T>*& last, Node<T>* first, Node<T>* last_of_chain) noexcept {
+			if (last)
+				last->next = first;
+			else
+				head = first;
+			last = last_of_chain;
+		}
 
-		for (size_t i = 0; i < dist; ++i) 
-			*(begin++) = std::move(buffer[i]);
+		void join(Node<T>*& head, Node<T>*& last) const noexcept {
+			for (size_t c = 0; c < size; ++c) {
+				if (heads[c])
+					append(head, last, heads[c], tails[c]);
+			}
+		}
+	};
+
+	// radix_sort's input and output chains, 68 KB with 8-byte pointers, drawn from the list's allocator like
+	// dedup's table. On the stack they would not fit the small stacks some worker threads run on
+	struct Radix_buffers {
+		using Chains_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Radix_chains>;
+
+		Chains_alloc alloc;
+		Radix_chains* chains;
+
+		template <typename A>
+		explicit Radix_buffers(const A& list_alloc) : alloc(list_alloc) {
+			chains = std::allocator_traits<Chains_alloc>::allocate(alloc, 2);
+			for (size_t i = 0; i < 2; ++i)
+				::new (static_cast<void*>(chains + i)) Radix_chains;
+		}
+
+		Radix_buffers(const Radix_buffers&) = delete;
+		Radix_buffers& operator=(const Radix_buffers&) = delete;
+
+		~Radix_buffers() {
+			std::allocator_traits<Chains_alloc>::deallocate(alloc, chains, 2);
+		}
+	};
 
-		delete[] buffer;
+	// Where each of radix_sort's walks is: stream s reads chains chain[s] .. stop[s] - 1 of the pass's input,
+	// cur[s] is its next node, nullptr once it is done
+	struct Radix_streams {
+		Node<T>* cur[radix_streams];
+		size_t chain[radix_streams];
+		size_t stop[radix_streams];
+		size_t active;
+
+		// Splits the input into runs of whole digits of about total / radix_streams nodes each
+		void start(const Radix_chains& in, size_t total) noexcept {
+			size_t s = 0, seen = 0;
+			chain[0] = 0;
+			for (size_t d = 0; d < 256; ++d) {
+				if (s + 1 < radix_streams && seen >= (s + 1) * (total / radix_streams)) {
+					stop[s] = d * radix_streams;
+					chain[++s] = d * radix_streams;
+				}
+				seen += in.counts[d];
+			}
+			stop[s] = Radix_chains::size;
+			while (++s < radix_streams)
+				chain[s] = stop[s] = Radix_chains::size;
+
+			active = 0;
+			for (s = 0; s < radix_streams; ++s) {
+				cur[s] = nullptr;
+				if (chain[s] < stop[s]) {
+					--chain[s];
+					next_chain(in, s);
+				}
+			}
+		}
+
+		// Moves stream s to the head of its next non-empty chain
+		void next_chain(const Radix_chains& in, size_t s) noexcept {
+			bool was_active = cur[s] != nullptr;
+			cur[s] = nullptr;
+			while (++chain[s] < stop[s]) {
+				if (in.heads[chain[s]]) {
+					cur[s] = in.heads[chain[s]];
+					break;
+				}
+			}
+			if (was_active && !cur[s])
+				--active;
+			else if (!was_active && cur[s])
+				++active;
+		}
+	};
+
+	// Bottom-up merge sort of a null-terminated chain. bins[i] holds a sorted run of 2^i nodes
+	// taken from earlier in the chain than every run in bins[0..i), which keeps the sort stable
+	template <typename Compare>
+	static Node<T>* sort_chain(Node<T>* first, Compare& comp) {
+		Node<T>* bins[64] = {};
+		size_t used = 0;
+
+		while (first) {
+			Node<T>* carry = first;
+			first = first->next;
+			carry->next = nullptr;
+
+			size_t i = 0;
+			for (; i < used && bins[i]; ++i) {
+				carry = merge_chains(bins[i], carry, comp);
+				bins[i] = nullptr;
+			}
+
+			bins[i] = carry;
+			if (i == used)
+				++used;
+		}
+
+		Node<T>* result = nullptr;
+		for (size_t i = 0; i < used; ++i)
+			result = merge_chains(bins[i], result, comp);
+
+		return result;
+	}
+
+	// Runs f(0) .. f(count - 1), all but f(0) on the pool, and waits for every one of them.
+	// The first exception thrown is rethrown once nothing is running anymore
+	template <typename Pool, typename F>
+	static void run_on(Pool& pool, size_t count, F& f) {
+		using Future = decltype(pool.submit(std::function<void()>()));
+		std::vector<Future> pending;
+		pending.reserve(count);
+		for (size_t i = 1; i < count; ++i)
+			pending.push_back(pool.submit([&f, i] { f(i); }));
+
+		std::exception_ptr error;
+		try {
+			f(0);
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+
+		for (Future& p : pending) {
+			try {
+				p.get();
+			}
+			catch (...) {
+				if (!error)
+					error = std::current_exception();
+			}
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	// Calls visit(node) on the nodes in order until it returns false, and returns that node, or nullptr
+	template <bool Prefetch, typename Visit>
+	Node<T>* walk(Visit&& visit) const {
+		for (Node<T>* node = head; node; ) {
+			Node<T>* next = node->next;
+			if constexpr (Prefetch)
+				prefetch(next);
+
+			if (!visit(node))
+				return node;
+			node = next;
+		}
+		return nullptr;
+	}
+
+	// Calls visit(part, node) on the nodes of split's parts [first, last), in order within each part, until it
+	// returns false for that part. traversal_streams parts are walked interleaved, a new part taking over each
+	// stream as it finishes one, so that many independent cache misses are in flight instead of one; each stream
+	// prefetches its next node a round of streams before reaching it
+	template <typename Visit>
+	void walk_parts(const Split& split, size_t first, size_t last, Visit&& visit) const {
+		Node<T>* cur[traversal_streams];
+		const Node<T>* stop[traversal_streams];
+		size_t part[traversal_streams];
+		size_t next_part = first;
+
+		auto start = [&](size_t s) {
+			while (next_part < last) {
+				size_t i = next_part++;
+				Node<T>* begin = i ? split.starts[i] : head;
+				const Node<T>* end = i + 1 < split.parts() ? split.starts[i + 1] : nullptr;
+				if (begin && begin != end) {
+					cur[s] = begin;
+					stop[s] = end;
+					part[s] = i;
+					return true;
+				}
+			}
+			cur[s] = nullptr;
+			return false;
+		};
+
+		size_t active = 0;
+		for (size_t s = 0; s < traversal_streams; ++s)
+			active += start(s);
+
+		while (active) {
+			for (size_t s = 0; s < traversal_streams; ++s) {
+				Node<T>* node = cur[s];
+				if (!node)
+					continue;
+
+				Node<T>* next = node->next;
+				prefetch(next);
+				if (visit(part[s], node) && next != stop[s])
+					cur[s] = next;
+				else if (!start(s))
+					--active;
+			}
+		}
+	}
+
+	// Stands for the calling thread in place of a pool
+	struct No_pool {};
+
+	// Marks a reduce without a separate combine: op combines the part results too
+	struct Same_as_op {};
+
+	// Runs task(first, last) over consecutive groups of split's parts: all of them on the calling thread, or
+	// one group per pool worker as long as each group gets parallel_walk_grain nodes
+	template <typename Pool, typename Task>
+	void run_groups(Pool& pool, const Split& split, Task& task) const {
+		size_t parts = split.parts();
+		if (!parts)
+			return;
+
+		if constexpr (std::is_same_v<Pool, No_pool>)
+			task(size_t(0), parts);
+		else {
+			size_t groups = std::min({ pool.size(), parts, std::max<size_t>(1, sz / parallel_walk_grain) });
+			auto group = [&task, parts, groups](size_t g) { task(parts * g / groups, parts * (g + 1) / groups); };
+			run_on(pool, groups, group);
+		}
+	}
+
+	// One part's result, a cache line each so that parts walked by different threads never share a line
+	template <typename V>
+	struct alignas(64) Part_result {
+		V value;
+	};
+
+	template <typename Pool, typename UnaryFunction>
+	void for_each_parts(Pool& pool, const Split& split, UnaryFunction& f) {
+		auto task = [this, &split, &f](size_t first, size_t last) {
+			UnaryFunction g = f;
+			walk_parts(split, first, last, [&g](size_t, Node<T>* node) {
+				g(node->val);
+				return true;
+			});
+		};
+		run_groups(pool, split, task);
+	}
+
+	template <typename Pool, typename Result, typename BinaryOperation, typename Combine>
+	Result reduce_parts(Pool& pool, const Split& split, Result identity, BinaryOperation& op, Combine& combine) const {
+		std::vector<Part_result<Result>> partial(split.parts(), Part_result<Result>{ identity });
+		auto task = [this, &split, &op, &partial](size_t first, size_t last) {
+			BinaryOperation o = op;
+			walk_parts(split, first, last, [&o, &partial](size_t part, Node<T>* node) {
+				partial[part].value = o(std::move(partial[part].value), std::as_const(node->val));
+				return true;
+			});
+		};
+		run_groups(pool, split, task);
+
+		for (Part_result<Result>& p : partial) {
+			if constexpr (std::is_same_v<Combine, Same_as_op>)
+				identity = op(std::move(identity), std::move(p.value));
+			else
+				identity = combine(std::move(identity), std::move(p.value));
+		}
+		return identity;
+	}
+
+	template <typename Pool, typename UnaryPredicate>
+	size_type count_parts(Pool& pool, const Split& split, UnaryPredicate& p) const {
+		std::vector<Part_result<size_type>> counts(split.parts(), Part_result<size_type>{ 0 });
+		auto task = [this, &split, &p, &counts](size_t first, size_t last) {
+			UnaryPredicate q = p;
+			walk_parts(split, first, last, [&q, &counts](size_t part, Node<T>* node) {
+				counts[part].value += q(std::as_const(node->val)) ? 1 : 0;
+				return true;
+			});
+		};
+		run_groups(pool, split, task);
+
+		size_type count = 0;
+		for (Part_result<size_type>& c : counts)
+			count += c.value;
+		return count;
+	}
+
+	// Each part stops at its first match, and parts after the earliest one matched so far stop early
+	template <typename Pool, typename UnaryPredicate>
+	Node<T>* find_parts(Pool& pool, const Split& split, UnaryPredicate& p) const {
+		std::vector<Part_result<Node<T>*>> found(split.parts(), Part_result<Node<T>*>{ nullptr });
+		std::atomic<size_t> first_found{ split.parts() };
+		auto task = [this, &split, &p, &found, &first_found](size_t first, size_t last) {
+			UnaryPredicate q = p;
+			walk_parts(split, first, last, [&q, &found, &first_found](size_t part, Node<T>* node) {
+				if (part > first_found.load(std::memory_order_relaxed))
+					return false;
+				if (!q(std::as_const(node->val)))
+					return true;
+
+				found[part].value = node;
+				size_t seen = first_found.load(std::memory_order_relaxed);
+				while (part < seen && !first_found.compare_exchange_weak(seen, part, std::memory_order_relaxed)) {}
+				return false;
+			});
+		};
+		run_groups(pool, split, task);
+
+		size_t i = first_found.load(std::memory_order_relaxed);
+		return i < found.size() ? found[i].value : nullptr;
 	}
 
 public:
 	template <typename Compare = std::less<T>>
 	void sort(Compare comp = Compare()) {
-		merge_sort(begin(), end(), comp);
+		CONTAINER_STATS_COUNT(sorts, 1);
+		CONTAINER_STATS_TIME(sort_ns);
+		drop_index();
+		head = sort_chain(head, comp);
+		find_tail();
 	}	
 
-	using NodeAlloc = typename Allocator::template rebind<Node<T>>::other;
+	// Stable LSD radix sort on an integral key: key(element), or the element itself by default. Each pass
+	// distributes the nodes by one byte of the key into bucket chains by relinking them; the only allocation is
+	// one block for the bucket heads and tails (68 KB, see Radix_buffers). The first pass, on the lowest byte,
+	// also finds the bytes that are the same in every key, and their passes are skipped: ids below 65536 take two.
+	// A pass over a list too big for the cache is bound by the miss on every next pointer, so after the first
+	// one radix_streams walks run interleaved, each over its own share of the previous pass's buckets and into
+	// its own buckets.
+	// Signed keys sort negatives first. If key throws, every node stays in the list, in unspecified order;
+	// if allocating the buckets throws, the list is unchanged
+	template <typename KeyExtractor = Identity_key>
+	void radix_sort(KeyExtractor key = KeyExtractor()) {
+		using Key = std::decay_t<std::invoke_result_t<KeyExtractor&, const T&>>;
+		static_assert(std::is_integral_v<Key> && !std::is_same_v<Key, bool>, "radix_sort needs an integral key");
+		using Bits = std::make_unsigned_t<Key>;
+
+		if (sz < 2)
+			return;
+
+		CONTAINER_STATS_COUNT(sorts, 1);
+		CONTAINER_STATS_TIME(sort_ns);
+		drop_index();
+
+		// Flipping the sign bit makes signed keys order correctly as unsigned
+		auto bits_of = [&key](const T& val) {
+			Bits bits = static_cast<Bits>(key(val));
+			if constexpr (std::is_signed_v<Key>)
+				bits ^= static_cast<Bits>(Bits(1) << (sizeof(Bits) * 8 - 1));
+			return bits;
+		};
+
+		// The first pass, on the lowest byte, also finds out which bytes vary
+		Bits any = 0, all = static_cast<Bits>(~Bits(0));
+		Bits varying = 0xff;
+
+		// The list in order is chain 0, 1, ... of the last pass; chain d * streams + s holds what stream s put
+		// in bucket d. Before the first pass it is a single chain
+		Radix_buffers buffers(alloc);
+		Radix_chains* in = &buffers.chains[0];
+		Radix_chains* out = &buffers.chains[1];
+		in->clear();
+		in->heads[0] = head;
+		in->tails[0] = tail;
+		in->counts[0] = sz;
+
+		Radix_streams streams{};
+		try {
+			for (unsigned shift = 0; shift < sizeof(Bits) * 8; shift += 8) {
+				if (((varying >> shift) & 0xff) == 0)
+					continue;
+
+				out->clear();
+				streams.start(*in, sz);
+				while (streams.active) {
+					for (size_t s = 0; s < radix_streams; ++s) {
+						Node<T>* node = streams.cur[s];
+						if (!node)
+							continue;
+
+						Bits bits = bits_of(node->val);
+						if (shift == 0) {
+							any |= bits;
+							all &= bits;
+						}
+
+						size_t d = static_cast<size_t>((bits >> shift) & 0xff);
+						size_t c = d * radix_streams + s;
+						if (out->heads[c])
+							out->tails[c]->next = node;
+						else
+							out->heads[c] = node;
+						out->tails[c] = node;
+						++out->counts[d];
+
+						// Appending only rewrites the next of a node already passed, so node->next is still the input's
+						if (node != in->tails[streams.chain[s]])
+							streams.cur[s] = node->next;
+						else
+							streams.next_chain(*in, s);
+					}
+				}
+				std::swap(in, out);
+				if (shift == 0)
+					varying = any ^ all;
+			}
+		}
+		catch (...) {
+			// Every node is either in out's chains or in what the streams have not reached
+			Node<T>* last = nullptr;
+			head = nullptr;
+			out->join(head, last);
+			for (size_t s = 0; s < radix_streams; ++s) {
+				while (streams.cur[s]) {
+					Radix_chains::append(head, last, streams.cur[s], in->tails[streams.chain[s]]);
+					streams.next_chain(*in, s);
+				}
+			}
+			tail = last;
+			tail->next = nullptr;
+			throw;
+		}
+
+		Node<T>* last = nullptr;
+		head = nullptr;
+		in->join(head, last);
+		tail = last;
+		tail->next = nullptr;
+	}
+
+	// Minimum number of nodes per run for parallel_sort to hand work to another thread
+	static constexpr size_type parallel_sort_grain = size_type(1) << 14;
+
+	// Stable sort spread over pool's workers: the list is cut into one run per worker by relinking,
+	// the runs are sorted concurrently and then merged pairwise, each round of merges concurrently too.
+	// Nodes are only relinked, elements are never copied or moved. comp is copied into every task.
+	// Pool is anything with size() and submit(f) returning a std::future, e.g. Thread_pool (Thread_pool/Thread_pool.h)
+	template <typename Pool, typename Compare = std::less<T>>
+	void parallel_sort(Pool& pool, Compare comp = Compare()) {
+		size_t runs = std::min<size_t>(pool.size(), sz / parallel_sort_grain);
+		if (runs < 2) {
+			sort(comp);
+			return;
+		}
+
+		CONTAINER_STATS_COUNT(sorts, 1);
+		CONTAINER_STATS_TIME(sort_ns);
+		drop_index();
+		std::vector<Node<T>*> chains(runs);
+		Node<T>* cur = head;
+		for (size_t i = 0; i < runs; ++i) {
+			chains[i] = cur;
+			size_t len = i + 1 < runs ? sz / runs : sz - (runs - 1) * (sz / runs);
+			for (size_t j = 1; j < len; ++j)
+				cur = cur->next;
+
+			Node<T>* next = cur->next;
+			cur->next = nullptr;
+			cur = next;
+		}
+
+		auto sort_run = [&chains, &comp](size_t i) {
+			Compare c = comp;
+			chains[i] = sort_chain(chains[i], c);
+		};
+		run_on(pool, runs, sort_run);
+
+		// Run i merges with run i + 1 only, so equal elements keep their relative order
+		while (chains.size() > 1) {
+			size_t pairs = chains.size() / 2;
+			auto merge_pair = [&chains, &comp](size_t i) {
+				Compare c = comp;
+				chains[2 * i] = merge_chains(chains[2 * i], chains[2 * i + 1], c);
+			};
+			run_on(pool, pairs, merge_pair);
+
+			for (size_t i = 0; i < chains.size(); i += 2)
+				chains[i / 2] = chains[i];
+			chains.resize((chains.size() + 1) / 2);
+		}
+
+		head = chains[0];
+		find_tail();
+	}
+
+	// Traversal. The plain forms visit the elements in order, like the std algorithms over begin() and end(), and
+	// Prefetch is as for remove_if. The forms taking a Split walk traversal_streams of its parts interleaved (see
+	// walk_parts), which pays off once the list outgrows the cache: give it at least that many parts. The parallel
+	// forms also spread the parts over pool's workers, pool as for parallel_sort; without a Split they first cut
+	// the list with split_into, a serial walk unless the skip index is built, so keep a Split for several passes.
+	// The elements of a part are visited in order, the parts in no particular order, and function objects are
+	// copied into every thread. If one throws, the exception propagates once no thread is walking anymore
+
+	// Parts walked interleaved by one thread
+	static constexpr size_type traversal_streams = 16;
+
+	// Minimum number of nodes for a parallel traversal to hand each worker
+	static constexpr size_type parallel_walk_grain = size_type(1) << 15;
+
+	// Cuts the list into min(parts, size()) parts of about equal length, in O(parts * stride) steps once the skip
+	// index is built. The non-const form builds it first; the const one makes a walk over the list without it
+	ND Split split_into(size_type parts) {
+		index();
+		return std::as_const(*this).split_into(parts);
+	}
+
+	ND Split split_into(size_type parts) const {
+		Split split;
+		parts = std::min(parts, sz);
+		split.starts.reserve(parts);
+		Node<T>* node = head;
+		size_type pos = 0;
+		for (size_type i = 0; i < parts; ++i) {
+			size_type start = i * sz / parts;
+			node = seek(skip.get(), node, pos, start);
+			pos = start;
+			split.starts.push_back(node);
+		}
+		return split;
+	}
+
+	template <bool Prefetch = false, typename UnaryFunction>
+	UnaryFunction for_each(UnaryFunction f) {
+		walk<Prefetch>([&f](Node<T>* node) {
+			f(node->val);
+			return true;
+		});
+		return f;
+	}
+
+	template <typename UnaryFunction>
+	void for_each(const Split& split, UnaryFunction f) {
+		No_pool calling_thread;
+		for_each_parts(calling_thread, split, f);
+	}
+
+	template <typename Pool, typename UnaryFunction>
+	void parallel_for_each(Pool& pool, const Split& split, UnaryFunction f) {
+		for_each_parts(pool, split, f);
+	}
+
+	template <typename Pool, typename UnaryFunction>
+	void parallel_for_each(Pool& pool, UnaryFunction f) {
+		parallel_for_each(pool, split_into(pool.size() * traversal_streams), f);
+	}
+
+	// Replaces every element x with f(x)
+	template <bool Prefetch = false, typename UnaryOperation>
+	void transform_inplace(UnaryOperation f) {
+		for_each<Prefetch>([&f](T& x) { x = f(std::as_const(x)); });
+	}
+
+	template <typename UnaryOperation>
+	void transform_inplace(const Split& split, UnaryOperation f) {
+		for_each(split, [f](T& x) mutable { x = f(std::as_const(x)); });
+	}
+
+	template <typename Pool, typename UnaryOperation>
+	void parallel_transform_inplace(Pool& pool, const Split& split, UnaryOperation f) {
+		parallel_for_each(pool, split, [f](T& x) mutable { x = f(std::as_const(x)); });
+	}
+
+	template <typename Pool, typename UnaryOperation>
+	void parallel_transform_inplace(Pool& pool, UnaryOperation f) {
+		parallel_for_each(pool, [f](T& x) mutable { x = f(std::as_const(x)); });
+	}
+
+	// Left fold in order: op(...op(op(init, x0), x1)..., xn)
+	template <bool Prefetch = false, typename Result, typename BinaryOperation>
+	ND Result reduce(Result init, BinaryOperation op) const {
+		walk<Prefetch>([&init, &op](Node<T>* node) {
+			init = op(std::move(init), std::as_const(node->val));
+			return true;
+		});
+		return init;
+	}
+
+	// Folds each part in order from identity with op, then the part results in list order with combine (op by
+	// default), so op need not be commutative; combine must be associative with identity as its neutral element.
+	// E.g. summing a field: reduce(split, 0.0, [](double s, const Row& r) { return s + r.price; }, std::plus<>())
+	template <typename Result, typename BinaryOperation, typename Combine = Same_as_op>
+	ND Result reduce(const Split& split, Result identity, BinaryOperation op, Combine combine = Combine()) const {
+		No_pool calling_thread;
+		return reduce_parts(calling_thread, split, std::move(identity), op, combine);
+	}
+
+	template <typename Pool, typename Result, typename BinaryOperation, typename Combine = Same_as_op>
+	ND Result parallel_reduce(Pool& pool, const Split& split, Result identity, BinaryOperation op,
+		Combine combine = Combine()) const {
+		return reduce_parts(pool, split, std::move(identity), op, combine);
+	}
+
+	template <typename Pool, typename Result, typename BinaryOperation, typename Combine = Same_as_op,
+		std::enable_if_t<!std::is_same_v<std::decay_t<Result>, Split>, int> = 0>
+	ND Result parallel_reduce(Pool& pool, Result identity, BinaryOperation op, Combine combine = Combine()) const {
+		return reduce_parts(pool, split_into(pool.size() * traversal_streams), std::move(identity), op, combine);
+	}
+
+	template <bool Prefetch = false, typename UnaryPredicate>
+	ND size_type count_if(UnaryPredicate p) const {
+		size_type count = 0;
+		walk<Prefetch>([&count, &p](Node<T>* node) {
+			count += p(std::as_const(node->val)) ? 1 : 0;
+			return true;
+		});
+		return count;
+	}
+
+	template <typename UnaryPredicate>
+	ND size_type count_if(const Split& split, UnaryPredicate p) const {
+		No_pool calling_thread;
+		return count_parts(calling_thread, split, p);
+	}
+
+	template <typename Pool, typename UnaryPredicate>
+	ND size_type parallel_count_if(Pool& pool, const Split& split, UnaryPredicate p) const {
+		return count_parts(pool, split, p);
+	}
+
+	template <typename Pool, typename UnaryPredicate>
+	ND size_type parallel_count_if(Pool& pool, UnaryPredicate p) const {
+		return parallel_count_if(pool, split_into(pool.size() * traversal_streams), p);
+	}
+
+	// The first element for which p is true, or end(). The forms taking a Split also return the first one in
+	// list order, stopping every part after it as soon as it is found
+	template <bool Prefetch = false, typename UnaryPredicate>
+	ND iterator find_if(UnaryPredicate p) {
+		return iterator(walk<Prefetch>([&p](Node<T>* node) { return !p(std::as_const(node->val)); }));
+	}
+
+	template <bool Prefetch = false, typename UnaryPredicate>
+	ND const_iterator find_if(UnaryPredicate p) const {
+		return const_iterator(walk<Prefetch>([&p](Node<T>* node) { return !p(std::as_const(node->val)); }));
+	}
+
+	template <typename UnaryPredicate>
+	ND iterator find_if(const Split& split, UnaryPredicate p) {
+		No_pool calling_thread;
+		return iterator(find_parts(calling_thread, split, p));
+	}
+
+	template <typename UnaryPredicate>
+	ND const_iterator find_if(const Split& split, UnaryPredicate p) const {
+		No_pool calling_thread;
+		return const_iterator(find_parts(calling_thread, split, p));
+	}
+
+	template <typename Pool, typename UnaryPredicate>
+	ND iterator parallel_find_if(Pool& pool, const Split& split, UnaryPredicate p) {
+		return iterator(find_parts(pool, split, p));
+	}
+
+	template <typename Pool, typename UnaryPredicate>
+	ND const_iterator parallel_find_if(Pool& pool, const Split& split, UnaryPredicate p) const {
+		return const_iterator(find_parts(pool, split, p));
+	}
+
+	template <typename Pool, typename UnaryPredicate>
+	ND iterator parallel_find_if(Pool& pool, UnaryPredicate p) {
+		return parallel_find_if(pool, split_into(pool.size() * traversal_streams), p);
+	}
+
+	template <typename Pool, typename UnaryPredicate>
+	ND const_iterator parallel_find_if(Pool& pool, UnaryPredicate p) const {
+		return parallel_find_if(pool, split_into(pool.size() * traversal_streams), p);
+	}
+
+	// Skip index. advance, lower_bound, upper_bound and split_into use a sparse index of every stride-th node,
+	// built on first use with one walk over the list, to take O(log(n / stride) + stride) steps instead of O(n).
+	// It costs a pointer per stride nodes. Changes that move nodes or shift positions drop it, to be rebuilt on
+	// the next use; appending at the back (push_back, emplace_back, append, resize) keeps it, the new nodes being
+	// indexed on the next use. Only build_index and the non-const overloads build or extend it. The const ones read
+	// it as it is, so they can run concurrently like the rest of the const interface: without an index they walk
+	// from head, and past the last mark over nodes appended since
+
+	// Stride of an index built on first use
+	static constexpr size_type skip_stride = 32;
+
+	// Builds the skip index now, with a mark every stride nodes
+	void build_index(size_type stride = skip_stride) {
+		if (!skip)
+			new_index(stride);
+		skip->marks.clear();
+		skip->stride = std::max<size_type>(stride, 1);
+		index();
+	}
+
+	// Frees the skip index; the next use builds it again with skip_stride
+	void release_index() noexcept {
+		skip.reset();
+	}
+
+	// The element at position n, or end() if n >= size()
+	ND iterator advance(size_type n) {
+		return iterator(n < sz ? node_at(n) : nullptr);
+	}
+
+	ND const_iterator advance(size_type n) const {
+		return const_iterator(n < sz ? node_at(n) : nullptr);
+	}
+
+	// On a list sorted by comp: the first element x for which comp(x, key) is false, or end()
+	template <typename Key, typename Compare = std::less<>>
+	ND iterator lower_bound(const Key& key, Compare comp = Compare()) {
+		return iterator(partition_node([&](const T& x) { return comp(x, key); }));
+	}
+
+	template <typename Key, typename Compare = std::less<>>
+	ND const_iterator lower_bound(const Key& key, Compare comp = Compare()) const {
+		return const_iterator(partition_node([&](const T& x) { return comp(x, key); }));
+	}
+
+	// On a list sorted by comp: the first element x for which comp(key, x) is true, or end()
+	template <typename Key, typename Compare = std::less<>>
+	ND iterator upper_bound(const Key& key, Compare comp = Compare()) {
+		return iterator(partition_node([&](const T& x) { return !comp(key, x); }));
+	}
+
+	template <typename Key, typename Compare = std::less<>>
+	ND const_iterator upper_bound(const Key& key, Compare comp = Compare()) const {
+		return const_iterator(partition_node([&](const T& x) { return !comp(key, x); }));
+	}
+
+	using NodeAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Node<T>>;
 	
 	NodeAlloc alloc;
 	Node<T>* head = nullptr;
-	Node<T>* tail = nullptr;
+	Node<T>* tail = nullptr;	// last node, end() stays nullptr
 	size_t sz = 0;
+	std::unique_ptr<Skip_index, Skip_deleter> skip;	// nullptr until first built by a non-const member
+#ifdef CONTAINER_STATS
+	Operation_counters op_stats;
+#endif
 };
 
 
@@ -676,12 +2066,17 @@ ListCompareResult compare_lists(const Forward_list<T, Allocator>& lhs, const For
 
 template<typename T, typename Allocator>
 bool operator==(const Forward_list<T, Allocator>& lhs, const Forward_list<T, Allocator>& rhs) {
-    return compare_lists(lhs, rhs) == ListCompareResult::Equal;
+    return lhs.size() == rhs.size() && compare_lists(lhs, rhs) == ListCompareResult::Equal;
 }
 
 template<typename T, typename Allocator>
 bool operator!=(const Forward_list<T, Allocator>& lhs, const Forward_list<T, Allocator>& rhs) {
-    return compare_lists(lhs, rhs) != ListCompareResult::Equal;
+    return !(lhs == rhs);
+}
+
+template<typename T, typename Allocator>
+bool operator<(const Forward_list<T, Allocator>& lhs, const Forward_list<T, Allocator>& rhs) {
+    return compare_lists(lhs, rhs) == ListCompareResult::Less;
 }
 
 template<typename T, typename Allocator>
@@ -699,11 +2094,18 @@ bool operator>=(const Forward_list<T, Allocator>& lhs, const Forward_list<T, All
     return compare_lists(lhs, rhs) != ListCompareResult::Less;
 }
 
+namespace pmr
+{
+	// Forward_list on a std::pmr::memory_resource, e.g. a Monotonic_arena (Allocators/Monotonic_arena.h)
+	template <typename T>
+	using Forward_list = ::Forward_list<T, std::pmr::polymorphic_allocator<T>>;
+}
+
 namespace std
 {
 	template <typename T, typename Allocator>
 	void swap(Forward_list<T, Allocator>& l, Forward_list<T, Allocator>& r) {
-		l.swap(l, r);
+		l.swap(r);
 	}
 }
 
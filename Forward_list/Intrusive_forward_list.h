@@ -0,0 +1,465 @@
+#ifndef _Intrusive_Forward_List
+#define _Intrusive_Forward_List
+
+#define ND [[nodiscard]]
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+// Link embedded in the objects an Intrusive_forward_list chains together. Tag tells apart several hooks
+// of one object, so it can sit on several lists at once. Copying an object never copies its link.
+template <typename Tag = void>
+struct Intrusive_hook {
+	Intrusive_hook* next = nullptr;
+
+	Intrusive_hook() = default;
+	Intrusive_hook(const Intrusive_hook&) noexcept {}
+	Intrusive_hook& operator=(const Intrusive_hook&) noexcept { return *this; }
+};
+
+// Hook policy for T deriving from Intrusive_hook<Tag>
+template <typename T, typename Tag = void>
+struct Base_hook {
+	using hook_type = Intrusive_hook<Tag>;
+
+	static hook_type* to_hook(T& val) noexcept { return static_cast<hook_type*>(&val); }
+
+	static T& to_value(hook_type* hook) noexcept { return *static_cast<T*>(hook); }
+};
+
+// Hook policy for T holding an Intrusive_hook as the data member Member. The distance from an object to its hook
+// is measured on the first real object passed to to_hook: every hook reaches a list through to_hook, so
+// to_value never runs before that
+template <typename T, typename Hook_type, Hook_type T::* Member>
+struct Member_hook {
+	using hook_type = Hook_type;
+
+	static hook_type* to_hook(T& val) noexcept {
+		hook_type* hook = &(val.*Member);
+		if (offset.load(std::memory_order_relaxed) < 0) {
+			std::ptrdiff_t measured = reinterpret_cast<char*>(hook) - reinterpret_cast<char*>(std::addressof(val));
+			offset.store(measured, std::memory_order_relaxed);
+		}
+		return hook;
+	}
+
+	static T& to_value(hook_type* hook) noexcept {
+		return *reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - offset.load(std::memory_order_relaxed));
+	}
+
+private:
+	static inline std::atomic<std::ptrdiff_t> offset{ -1 };	// -1 until to_hook first runs
+};
+
+// Singly linked list of objects it does not own. Elements are chained through their own hook (see Base_hook and
+// Member_hook), so nothing is ever allocated or freed: insertion links the object itself, erasure only unlinks it
+// and the caller stays responsible for its lifetime. An object may be on one list per hook at a time and must
+// outlive its membership. Keeps the last node, so push_back and whole-list splices are O(1).
+template <typename T, typename Hook = Base_hook<T>>
+class Intrusive_forward_list {
+	using hook_type = typename Hook::hook_type;
+
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using difference_type	= std::ptrdiff_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+	using pointer			= value_type*;
+	using const_pointer		= const value_type*;
+
+private:
+	template <bool IsConst>
+	struct common_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = T;
+		using pointer = std::conditional_t<IsConst, const T*, T*>;
+		using reference = std::conditional_t<IsConst, const T&, T&>;
+
+		friend class Intrusive_forward_list;
+
+	private:
+		hook_type* ptr = nullptr;
+
+	public:
+		common_iterator() = default;
+
+		explicit common_iterator(hook_type* ptr) : ptr(ptr) {}
+
+		template <bool IsOtherConst, typename = std::enable_if_t<IsConst || !IsOtherConst>>
+		common_iterator(common_iterator<IsOtherConst> other) : ptr(other.ptr) {}
+
+		reference operator*() const {
+			return Hook::to_value(ptr);
+		}
+
+		pointer operator->() const {
+			return &Hook::to_value(ptr);
+		}
+
+		common_iterator& operator++() {
+			ptr = ptr->next;
+			return *this;
+		}
+
+		common_iterator operator++(int) {
+			common_iterator copy_iter(ptr);
+			++(*this);
+			return copy_iter;
+		}
+
+		template <bool IsOtherConst>
+		bool operator!=(common_iterator<IsOtherConst> other) const {
+			return ptr != other.ptr;
+		}
+
+		template <bool IsOtherConst>
+		bool operator==(common_iterator<IsOtherConst> other) const {
+			return ptr == other.ptr;
+		}
+	};
+
+public:
+	using iterator			=	common_iterator<false>;
+	using const_iterator	=	common_iterator<true>;
+
+	ND iterator before_begin() noexcept { return iterator(&root); }
+
+	ND const_iterator before_begin() const noexcept { return const_iterator(const_cast<hook_type*>(&root)); }
+
+	ND const_iterator cbefore_begin() const noexcept { return before_begin(); }
+
+	ND iterator begin() noexcept { return iterator(root.next); }
+
+	ND iterator end() noexcept { return iterator(nullptr); }
+
+	ND const_iterator begin() const noexcept { return const_iterator(root.next); }
+
+	ND const_iterator end() const noexcept { return const_iterator(nullptr); }
+
+	ND const_iterator cbegin() const noexcept { return begin(); }
+
+	ND const_iterator cend() const noexcept { return end(); }
+
+	// Iterator to an element known to be on this list, in O(1)
+	ND iterator iterator_to(T& val) noexcept { return iterator(Hook::to_hook(val)); }
+
+
+	Intrusive_forward_list() = default;
+
+	template <class Iterator, typename std::enable_if_t<
+	std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>, int> = 0>
+	Intrusive_forward_list(Iterator first, Iterator last) {
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+
+	Intrusive_forward_list(const Intrusive_forward_list&) = delete;
+	Intrusive_forward_list& operator=(const Intrusive_forward_list&) = delete;
+
+	Intrusive_forward_list(Intrusive_forward_list&& other) noexcept {
+		take(other);
+	}
+
+	Intrusive_forward_list& operator=(Intrusive_forward_list&& other) noexcept {
+		if (this != &other) {
+			clear();
+			take(other);
+		}
+		return *this;
+	}
+
+	~Intrusive_forward_list() { clear(); }
+
+
+	// Element access
+	ND reference front() noexcept { return Hook::to_value(root.next); }
+
+	ND const_reference front() const noexcept { return Hook::to_value(root.next); }
+
+	ND reference back() noexcept { return Hook::to_value(tail); }
+
+	ND const_reference back() const noexcept { return Hook::to_value(tail); }
+
+
+	// Capacity
+	ND bool empty() const noexcept { return sz == 0; }
+
+	ND size_type size() const noexcept { return sz; }
+
+
+	// Modifiers
+	// Unlinks every element; the objects themselves are untouched
+	void clear() noexcept {
+		hook_type* cur = root.next;
+		while (cur) {
+			hook_type* next = cur->next;
+			cur->next = nullptr;
+			cur = next;
+		}
+
+		root.next = nullptr;
+		tail = &root;
+		sz = 0;
+	}
+
+	void push_front(T& val) noexcept {
+		link_after(&root, Hook::to_hook(val));
+	}
+
+	void push_back(T& val) noexcept {
+		link_after(tail, Hook::to_hook(val));
+	}
+
+	void pop_front() noexcept {
+		unlink_after(&root);
+	}
+
+	iterator insert_after(const_iterator pos, T& val) noexcept {
+		hook_type* hook = Hook::to_hook(val);
+		link_after(pos.ptr, hook);
+		return iterator(hook);
+	}
+
+	// Unlinks the element after pos. Returns the element that followed it
+	iterator erase_after(const_iterator pos) noexcept {
+		unlink_after(pos.ptr);
+		return iterator(pos.ptr->next);
+	}
+
+	// Unlinks the elements in (first, last)
+	iterator erase_after(const_iterator first, const_iterator last) noexcept {
+		while (first.ptr->next != last.ptr)
+			unlink_after(first.ptr);
+		return iterator(last.ptr);
+	}
+
+	// Unlinks val, found by walking from the front. Returns false if it is not on the list
+	bool erase(T& val) noexcept {
+		hook_type* hook = Hook::to_hook(val);
+		for (hook_type* prev = &root; prev->next; prev = prev->next) {
+			if (prev->next == hook) {
+				unlink_after(prev);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void swap(Intrusive_forward_list& other) noexcept {
+		Intrusive_forward_list tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+
+	// Operations
+	// O(1)
+	void splice_after(const_iterator pos, Intrusive_forward_list& other) noexcept {
+		if (this == &other || other.empty()) return;
+
+		hook_type* pointer_to_pos = pos.ptr;
+		other.tail->next = pointer_to_pos->next;
+		pointer_to_pos->next = other.root.next;
+		if (pointer_to_pos == tail)
+			tail = other.tail;
+		sz += other.sz;
+
+		other.root.next = nullptr;
+		other.tail = &other.root;
+		other.sz = 0;
+	}
+
+	// Moves the element after it from other to after pos
+	void splice_after(const_iterator pos, Intrusive_forward_list& other, const_iterator it) noexcept {
+		hook_type* pointer_to_pos = pos.ptr;
+		hook_type* pointer_to_it = it.ptr;
+		hook_type* moved = pointer_to_it->next;
+		if (!moved || pointer_to_pos == pointer_to_it || pointer_to_pos == moved) return;
+
+		other.unlink_after(pointer_to_it);
+		link_after(pointer_to_pos, moved);
+	}
+
+	// Moves the elements in (first, last) from other to after pos
+	void splice_after(const_iterator pos, Intrusive_forward_list& other, const_iterator first, const_iterator last) noexcept {
+		hook_type* before_first = first.ptr;
+		hook_type* chain_first = before_first->next;
+		if (chain_first == last.ptr) return;
+
+		size_type count = 1;
+		hook_type* chain_last = chain_first;
+		while (chain_last->next != last.ptr) {
+			chain_last = chain_last->next;
+			++count;
+		}
+
+		before_first->next = last.ptr;
+		if (chain_last == other.tail)
+			other.tail = before_first;
+		other.sz -= count;
+
+		hook_type* pointer_to_pos = pos.ptr;
+		chain_last->next = pointer_to_pos->next;
+		pointer_to_pos->next = chain_first;
+		if (pointer_to_pos == tail)
+			tail = chain_last;
+		sz += count;
+	}
+
+	// Moves every element of other to the end of this list in O(1)
+	void append(Intrusive_forward_list&& other) noexcept {
+		splice_after(const_iterator(tail), other);
+	}
+
+	// Unlinks every element satisfying p. Returns how many were unlinked
+	template <typename UnaryPredicate>
+	size_type remove_if(UnaryPredicate p) {
+		size_type removed = 0;
+		hook_type* prev = &root;
+		while (prev->next) {
+			if (p(Hook::to_value(prev->next))) {
+				unlink_after(prev);
+				++removed;
+			}
+			else {
+				prev = prev->next;
+			}
+		}
+		return removed;
+	}
+
+	size_type remove(const T& val) {
+		return remove_if([&val](const T& x) { return x == val; });
+	}
+
+	void reverse() noexcept {
+		hook_type* left = nullptr;
+		hook_type* right = root.next;
+		tail = right ? right : &root;
+
+		while (right) {
+			hook_type* next_to_right = right->next;
+			right->next = left;
+			left = right;
+			right = next_to_right;
+		}
+
+		root.next = left;
+	}
+
+	// Merges sorted other into this sorted list. Stable: on ties elements of this list go first
+	template <typename Compare = std::less<T>>
+	void merge(Intrusive_forward_list& other, Compare comp = Compare()) {
+		if (this == &other || other.empty()) return;
+
+		hook_type* new_tail = sz && comp(Hook::to_value(other.tail), Hook::to_value(tail)) ? tail : other.tail;
+		root.next = merge_chains(root.next, other.root.next, comp);
+		tail = new_tail;
+		sz += other.sz;
+
+		other.root.next = nullptr;
+		other.tail = &other.root;
+		other.sz = 0;
+	}
+
+	// Stable bottom-up merge sort by relinking hooks, no element is moved
+	template <typename Compare = std::less<T>>
+	void sort(Compare comp = Compare()) {
+		hook_type* bins[64] = {};
+		size_t used = 0;
+		hook_type* first = root.next;
+
+		while (first) {
+			hook_type* carry = first;
+			first = first->next;
+			carry->next = nullptr;
+
+			size_t i = 0;
+			for (; i < used && bins[i]; ++i) {
+				carry = merge_chains(bins[i], carry, comp);
+				bins[i] = nullptr;
+			}
+
+			bins[i] = carry;
+			if (i == used)
+				++used;
+		}
+
+		hook_type* result = nullptr;
+		for (size_t i = 0; i < used; ++i)
+			result = merge_chains(bins[i], result, comp);
+
+		root.next = result;
+		tail = &root;
+		while (tail->next)
+			tail = tail->next;
+	}
+
+private:
+	void link_after(hook_type* pos, hook_type* hook) noexcept {
+		hook->next = pos->next;
+		pos->next = hook;
+		if (pos == tail)
+			tail = hook;
+		++sz;
+	}
+
+	void unlink_after(hook_type* pos) noexcept {
+		hook_type* hook = pos->next;
+		pos->next = hook->next;
+		hook->next = nullptr;
+		if (hook == tail)
+			tail = pos;
+		--sz;
+	}
+
+	void take(Intrusive_forward_list& other) noexcept {
+		root.next = std::exchange(other.root.next, nullptr);
+		tail = other.tail == &other.root ? &root : other.tail;
+		sz = std::exchange(other.sz, 0);
+		other.tail = &other.root;
+	}
+
+	// Merges two sorted null-terminated chains by relinking. On ties nodes of `left` go first
+	template <typename Compare>
+	static hook_type* merge_chains(hook_type* left, hook_type* right, Compare& comp) {
+		hook_type* first = nullptr;
+		hook_type** link = &first;
+
+		while (left && right) {
+			if (comp(Hook::to_value(right), Hook::to_value(left))) {
+				*link = right;
+				right = right->next;
+			}
+			else {
+				*link = left;
+				left = left->next;
+			}
+			link = &(*link)->next;
+		}
+
+		*link = left ? left : right;
+		return first;
+	}
+
+	hook_type root;				// before_begin(); root.next is the first element
+	hook_type* tail = &root;	// last element, &root while empty
+	size_type sz = 0;
+};
+
+template <typename T, typename Hook>
+void swap(Intrusive_forward_list<T, Hook>& lhs, Intrusive_forward_list<T, Hook>& rhs) noexcept {
+	lhs.swap(rhs);
+}
+
+
+#endif // !_Intrusive_Forward_List
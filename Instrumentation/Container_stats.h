@@ -0,0 +1,177 @@
+#ifndef _Container_Stats
+#define _Container_Stats
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+
+// Snapshot a container returns from stats(), plain numbers ready to export to a metrics system.
+// The allocation half is filled in when the container's allocator is a Counting_allocator
+// (Allocators/Counting_allocator.h), whatever the build flags. The operation half and the sort/merge timings
+// are only counted when CONTAINER_STATS is defined; without it the hooks compile to nothing and stay zero.
+struct Container_stats {
+	// Allocation, in objects of whatever type the container allocates (nodes for Forward_list)
+	std::uint64_t allocations = 0;		// allocate() calls
+	std::uint64_t deallocations = 0;
+	std::uint64_t live_nodes = 0;
+	std::uint64_t peak_nodes = 0;
+	std::uint64_t bytes_allocated = 0;	// over the allocator's lifetime
+	std::uint64_t live_bytes = 0;
+	std::uint64_t peak_bytes = 0;
+
+	// Operations: elements for push/pop/insert/erase, calls for the rest
+	std::uint64_t pushes = 0;
+	std::uint64_t pops = 0;
+	std::uint64_t inserts = 0;
+	std::uint64_t erases = 0;
+	std::uint64_t splices = 0;
+	std::uint64_t sorts = 0;
+	std::uint64_t merges = 0;
+	std::uint64_t sort_ns = 0;
+	std::uint64_t merge_ns = 0;
+
+	// Calls f(name, value) for every counter
+	template <typename F>
+	void for_each(F&& f) const {
+		f("allocations", allocations);
+		f("deallocations", deallocations);
+		f("live_nodes", live_nodes);
+		f("peak_nodes", peak_nodes);
+		f("bytes_allocated", bytes_allocated);
+		f("live_bytes", live_bytes);
+		f("peak_bytes", peak_bytes);
+		f("pushes", pushes);
+		f("pops", pops);
+		f("inserts", inserts);
+		f("erases", erases);
+		f("splices", splices);
+		f("sorts", sorts);
+		f("merges", merges);
+		f("sort_ns", sort_ns);
+		f("merge_ns", merge_ns);
+	}
+};
+
+// What a Counting_allocator and every copy or rebind of it record together
+struct Allocation_counters {
+	std::uint64_t allocations = 0;
+	std::uint64_t deallocations = 0;
+	std::uint64_t live_nodes = 0;
+	std::uint64_t peak_nodes = 0;
+	std::uint64_t bytes_allocated = 0;
+	std::uint64_t live_bytes = 0;
+	std::uint64_t peak_bytes = 0;
+
+	void on_allocate(size_t n, size_t bytes) noexcept {
+		++allocations;
+		live_nodes += n;
+		bytes_allocated += bytes;
+		live_bytes += bytes;
+		if (live_nodes > peak_nodes)
+			peak_nodes = live_nodes;
+		if (live_bytes > peak_bytes)
+			peak_bytes = live_bytes;
+	}
+
+	void on_deallocate(size_t n, size_t bytes) noexcept {
+		++deallocations;
+		live_nodes -= n;
+		live_bytes -= bytes;
+	}
+};
+
+// Kept inside a container when CONTAINER_STATS is defined
+struct Operation_counters {
+	std::uint64_t pushes = 0;
+	std::uint64_t pops = 0;
+	std::uint64_t inserts = 0;
+	std::uint64_t erases = 0;
+	std::uint64_t splices = 0;
+	std::uint64_t sorts = 0;
+	std::uint64_t merges = 0;
+	std::uint64_t sort_ns = 0;
+	std::uint64_t merge_ns = 0;
+};
+
+namespace stats_detail {
+
+	template <typename A, typename = void>
+	struct has_counters : std::false_type {};
+
+	template <typename A>
+	struct has_counters<A, std::void_t<decltype(std::declval<const A&>().counters())>> : std::true_type {};
+
+	template <typename C, typename = void>
+	struct has_get_allocator : std::false_type {};
+
+	template <typename C>
+	struct has_get_allocator<C, std::void_t<decltype(std::declval<const C&>().get_allocator())>> : std::true_type {};
+
+	template <typename Alloc>
+	void add_allocations(Container_stats& s, const Alloc& alloc) noexcept {
+		if constexpr (has_counters<Alloc>::value) {
+			const Allocation_counters& c = alloc.counters();
+			s.allocations = c.allocations;
+			s.deallocations = c.deallocations;
+			s.live_nodes = c.live_nodes;
+			s.peak_nodes = c.peak_nodes;
+			s.bytes_allocated = c.bytes_allocated;
+			s.live_bytes = c.live_bytes;
+			s.peak_bytes = c.peak_bytes;
+		}
+	}
+
+	// For adapters: the underlying container's allocator, if it has one
+	template <typename Container>
+	void add_container_allocations(Container_stats& s, const Container& cont) {
+		if constexpr (has_get_allocator<Container>::value)
+			add_allocations(s, cont.get_allocator());
+	}
+
+	inline void add_operations(Container_stats& s, const Operation_counters& ops) noexcept {
+		s.pushes = ops.pushes;
+		s.pops = ops.pops;
+		s.inserts = ops.inserts;
+		s.erases = ops.erases;
+		s.splices = ops.splices;
+		s.sorts = ops.sorts;
+		s.merges = ops.merges;
+		s.sort_ns = ops.sort_ns;
+		s.merge_ns = ops.merge_ns;
+	}
+
+	// Adds the nanoseconds spent in its scope to a counter
+	class Scope_timer {
+	public:
+		explicit Scope_timer(std::uint64_t& into) noexcept : into(into), start(std::chrono::steady_clock::now()) {}
+
+		Scope_timer(const Scope_timer&) = delete;
+		Scope_timer& operator=(const Scope_timer&) = delete;
+
+		~Scope_timer() {
+			into += static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		}
+
+	private:
+		std::uint64_t& into;
+		std::chrono::steady_clock::time_point start;
+	};
+
+}
+
+// Hooks for the containers, used inside their member functions. They expect an Operation_counters member
+// named op_stats, which the containers only declare when CONTAINER_STATS is defined
+#ifdef CONTAINER_STATS
+#define CONTAINER_STATS_COUNT(field, n) (op_stats.field += (n))
+#define CONTAINER_STATS_TIME(field) stats_detail::Scope_timer stats_timer_##field(op_stats.field)
+#else
+#define CONTAINER_STATS_COUNT(field, n) ((void)0)
+#define CONTAINER_STATS_TIME(field) ((void)0)
+#endif
+
+
+#endif // !_Container_Stats
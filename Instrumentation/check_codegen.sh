@@ -0,0 +1,43 @@
+#!/bin/sh
+# Checks that the instrumentation hooks cost nothing when CONTAINER_STATS is off: compiles codegen_probe.cpp
+# against the headers of a baseline revision and against the working tree, then diffs the disassembly.
+# The baseline must have the same features as the working tree apart from the stats change being checked, or the
+# diff shows those features too: run it on uncommitted changes against HEAD, or on a commit against its parent.
+# 268fef5, the revision before the hooks were added in 817b7a3, only matches 817b7a3 itself; later work such as
+# the skip index (drop_index in every mutating Forward_list member) changes the code on purpose.
+# Usage: Instrumentation/check_codegen.sh <baseline-rev> [compiler flags...]
+# e.g.   Instrumentation/check_codegen.sh HEAD -O2 -std=c++17
+set -e
+
+if [ $# -lt 1 ]; then
+	echo "usage: $0 <baseline-rev> [compiler flags...]" >&2
+	exit 2
+fi
+
+base=$1
+shift
+[ $# -gt 0 ] || set -- -O2 -std=c++17
+
+root=$(git -C "$(dirname "$0")" rev-parse --show-toplevel)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+# The whole tree, so the headers find whatever they include at that revision
+mkdir "$work/base"
+git -C "$root" archive "$base" | tar -x -C "$work/base"
+mkdir -p "$work/base/Instrumentation"
+cp "$root/Instrumentation/codegen_probe.cpp" "$work/base/Instrumentation/"
+
+${CXX:-c++} "$@" -c "$work/base/Instrumentation/codegen_probe.cpp" -o "$work/base.o"
+${CXX:-c++} "$@" -c "$root/Instrumentation/codegen_probe.cpp" -o "$work/current.o"
+
+# Skip the header line that names the object file
+objdump -d --no-show-raw-insn -C "$work/base.o" | tail -n +3 > "$work/base.s"
+objdump -d --no-show-raw-insn -C "$work/current.o" | tail -n +3 > "$work/current.s"
+
+if diff -u "$work/base.s" "$work/current.s"; then
+	echo "identical code ($(grep -c '^ ' "$work/current.s") instructions) with $*"
+else
+	echo "code differs from $base with $*" >&2
+	exit 1
+fi
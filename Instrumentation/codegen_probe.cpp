@@ -0,0 +1,82 @@
+// Exercises every instrumented member of Forward_list, Stack and Queue so check_codegen.sh can compare the
+// machine code built without CONTAINER_STATS against a baseline revision.
+// Only uses members that 268fef5, from before the hooks existed, already has, so it compiles against any later baseline
+#include "../Forward_list/Forward_list.h"
+#include "../Queue/Queue.h"
+#include "../Stack/Stack.h"
+
+#include <string>
+#include <vector>
+
+
+using List = Forward_list<int>;
+using String_list = Forward_list<std::string>;
+
+void probe_push_pop(List& l, int x) {
+	l.push_front(x);
+	l.push_back(x);
+	l.emplace_front(x);
+	l.emplace_back(x);
+	l.pop_front();
+}
+
+void probe_insert_erase(List& l, const std::vector<int>& v, int x) {
+	l.insert_after(l.cbegin(), x);
+	l.insert_after(l.cbegin(), 3, x);
+	l.insert_after(l.cbegin(), v.begin(), v.end());
+	l.emplace_after(l.cbegin(), x);
+	l.erase_after(l.cbegin());
+	l.erase_after(l.cbegin(), l.cend());
+	l.resize(10, x);
+}
+
+size_t probe_filters(List& l, int x) {
+	size_t n = l.remove(x);
+	n += l.remove_if([x](int y) { return y < x; });
+	n += l.remove_if<true>([x](int y) { return y > x; });
+	n += l.extract_if([x](int y) { return y == x; }).size();
+	n += l.unique();
+	n += l.dedup();
+	return n;
+}
+
+void probe_splice(List& a, List& b) {
+	a.splice_after(a.cbegin(), b);
+	a.splice_after(a.cbegin(), b, b.cbegin());
+	a.splice_after(a.cbegin(), b, b.cbegin(), b.cend());
+	a.append(std::move(b));
+}
+
+void probe_sort_merge(List& a, List& b) {
+	a.sort();
+	b.sort([](int x, int y) { return x > y; });
+	a.merge(b);
+}
+
+void probe_strings(String_list& l, const std::string& s) {
+	l.push_back(s);
+	l.emplace_front(s);
+	l.pop_front();
+	l.remove(s);
+	l.sort();
+}
+
+void probe_stack(Stack<int>& s, Stack<int, std::vector<int>>& v, const std::vector<int>& in, int* out) {
+	s.push(1);
+	s.emplace(2);
+	s.pop();
+	s.push_range(in.begin(), in.end());
+	v.push_range(in.begin(), in.end());
+	v.pop_n(out, 4);
+	s.drain(out);
+}
+
+void probe_queue(Queue<int>& q, Queue<int, std::vector<int>>& v, const std::vector<int>& in, int* out) {
+	q.push(1);
+	q.emplace(2);
+	q.pop();
+	q.push_range(in.begin(), in.end());
+	v.push_range(in.begin(), in.end());
+	v.pop_n(out, 4);
+	q.drain(out);
+}
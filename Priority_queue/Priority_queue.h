@@ -0,0 +1,512 @@
+#ifndef _Priority_Queue
+#define _Priority_Queue
+
+#define ND [[nodiscard]]
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../Adapters/Adapter_traits.h"
+
+
+// Sift operations on a d-ary max-heap laid out in a random access range: the children of i are
+// Arity * i + 1 .. Arity * i + Arity, side by side, so a sift-down compares one or two cache lines per level
+// and the tree is log_Arity(n) deep instead of log_2(n). moved(element, index) is called for every element
+// that lands in a new place, which lets Handle_priority_queue keep its handles up to date.
+namespace dary_heap_detail {
+
+	template <size_t Arity, typename It, typename Compare, typename Moved>
+	void sift_up(It first, size_t i, Compare& comp, Moved&& moved) {
+		auto val = std::move(first[i]);
+		while (i > 0) {
+			size_t parent = (i - 1) / Arity;
+			if (!comp(first[parent], val))
+				break;
+			first[i] = std::move(first[parent]);
+			moved(first[i], i);
+			i = parent;
+		}
+		first[i] = std::move(val);
+		moved(first[i], i);
+	}
+
+	template <size_t Arity, typename It, typename Compare, typename Moved>
+	void sift_down(It first, size_t n, size_t i, Compare& comp, Moved&& moved) {
+		auto val = std::move(first[i]);
+		for (;;) {
+			size_t child = Arity * i + 1;
+			if (child >= n)
+				break;
+
+			size_t last = std::min(child + Arity, n);
+			size_t best = child;
+			for (++child; child < last; ++child) {
+				if (comp(first[best], first[child]))
+					best = child;
+			}
+
+			if (!comp(val, first[best]))
+				break;
+			first[i] = std::move(first[best]);
+			moved(first[i], i);
+			i = best;
+		}
+		first[i] = std::move(val);
+		moved(first[i], i);
+	}
+
+	// Removes the root of a heap of n elements: the hole left at the root walks down to a leaf along the greater
+	// children, then the last element goes into it and sifts up. The last element nearly always belongs near the
+	// bottom, so this saves the compare against it on every level that a plain sift-down would pay
+	template <size_t Arity, typename It, typename Compare, typename Moved>
+	void pop_root(It first, size_t n, Compare& comp, Moved&& moved) {
+		size_t last = n - 1;
+		size_t i = 0;
+		for (;;) {
+			size_t child = Arity * i + 1;
+			if (child >= last)
+				break;
+
+			size_t end = std::min(child + Arity, last);
+			size_t best = child;
+			for (++child; child < end; ++child) {
+				if (comp(first[best], first[child]))
+					best = child;
+			}
+
+			first[i] = std::move(first[best]);
+			moved(first[i], i);
+			i = best;
+		}
+
+		if (i != last) {
+			first[i] = std::move(first[last]);
+			sift_up<Arity>(first, i, comp, moved);
+		}
+	}
+
+	// Floyd's bottom-up construction, O(n)
+	template <size_t Arity, typename It, typename Compare, typename Moved>
+	void make_heap(It first, size_t n, Compare& comp, Moved&& moved) {
+		if (n < 2)
+			return;
+		for (size_t i = (n - 2) / Arity + 1; i-- > 0;)
+			sift_down<Arity>(first, n, i, comp, moved);
+	}
+
+	struct No_tracking {
+		template <typename U>
+		void operator()(const U&, size_t) const noexcept {}
+	};
+
+}
+
+
+// Priority queue adapter over a random access container, as a d-ary heap. Like std::priority_queue, top() is
+// the greatest element under Compare (std::greater gives a min-queue). Arity 4 or 8 keeps the children of
+// a node within a cache line or two for small T; 2 gives the classic binary heap.
+template <typename T, class Container = std::vector<T>, class Compare = std::less<typename Container::value_type>,
+	size_t Arity = 4>
+class Priority_queue {
+	static_assert(Arity >= 2, "Priority_queue needs an arity of at least 2");
+
+public:
+	using container_type	= Container;
+	using value_compare		= Compare;
+	using value_type		= typename Container::value_type;
+	using size_type			= typename Container::size_type;
+	using reference			= typename Container::reference;
+	using const_reference	= typename Container::const_reference;
+
+	static constexpr size_t arity = Arity;
+
+
+	Priority_queue() = default;
+
+	explicit Priority_queue(const Compare& comp) : comp(comp) {}
+
+	// The container's elements are heapified in O(n)
+	Priority_queue(const Compare& comp, const Container& cont) : cont(cont), comp(comp) {
+		heapify();
+	}
+
+	Priority_queue(const Compare& comp, Container&& cont) : cont(std::move(cont)), comp(comp) {
+		heapify();
+	}
+
+	template <class InputIt>
+	Priority_queue(InputIt first, InputIt last, const Compare& comp = Compare()) : comp(comp) {
+		push_range(first, last);
+	}
+
+	// Allocator-extended constructors. The forms taking a container copy or move it with alloc, then heapify it
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	explicit Priority_queue(const Alloc& alloc) : cont(alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Priority_queue(const Compare& comp, const Alloc& alloc) : cont(alloc), comp(comp) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Priority_queue(const Compare& comp, const Container& cont, const Alloc& alloc) : cont(cont, alloc), comp(comp) {
+		heapify();
+	}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Priority_queue(const Compare& comp, Container&& cont, const Alloc& alloc) : cont(std::move(cont), alloc), comp(comp) {
+		heapify();
+	}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Priority_queue(const Priority_queue& q, const Alloc& alloc) : cont(q.cont, alloc), comp(q.comp) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Priority_queue(Priority_queue&& q, const Alloc& alloc) : cont(std::move(q.cont), alloc), comp(std::move(q.comp)) {}
+
+
+	// Element access
+	const_reference top() const noexcept(noexcept(cont.front())) {
+		return cont.front();
+	}
+
+
+	// Capacity
+	ND size_type size() const noexcept(noexcept(cont.size())) {
+		return cont.size();
+	}
+
+	ND bool empty() const noexcept(noexcept(cont.empty())) {
+		return cont.empty();
+	}
+
+
+	// Modifiers
+	void push(const value_type& val) {
+		cont.push_back(val);
+		sift_up(cont.size() - 1);
+	}
+
+	void push(value_type&& val) {
+		cont.push_back(std::move(val));
+		sift_up(cont.size() - 1);
+	}
+
+	template<typename ... Args>
+	void emplace(Args&&... args) {
+		cont.emplace_back(std::forward<Args>(args)...);
+		sift_up(cont.size() - 1);
+	}
+
+	void pop() {
+		dary_heap_detail::pop_root<Arity>(cont.begin(), cont.size(), comp, dary_heap_detail::No_tracking());
+		cont.pop_back();
+	}
+
+	// Appends [first, last) and restores the heap: with Floyd's O(size()) construction when the range is at least
+	// as long as the queue already was, otherwise by sifting each new element up
+	template <class InputIt>
+	void push_range(InputIt first, InputIt last) {
+		size_type old_size = cont.size();
+		if constexpr (adapter_detail::has_range_insert<Container, InputIt>::value) {
+			cont.insert(cont.end(), first, last);
+		}
+		else {
+			for (; first != last; ++first)
+				cont.push_back(*first);
+		}
+
+		size_type added = cont.size() - old_size;
+		if (added >= old_size)
+			heapify();
+		else {
+			for (size_type i = old_size; i < cont.size(); ++i)
+				sift_up(i);
+		}
+	}
+
+	// Pops up to n elements into out, greatest first. Returns the end of the written range
+	template <class OutputIt>
+	OutputIt pop_n(OutputIt out, size_type n) {
+		n = std::min(n, cont.size());
+		for (; n; --n) {
+			*out++ = std::move(cont.front());
+			pop();
+		}
+		return out;
+	}
+
+	// Pops every element into out, greatest first
+	template <class OutputIt>
+	OutputIt drain(OutputIt out) {
+		return pop_n(out, cont.size());
+	}
+
+	void swap(Priority_queue& rhs) noexcept(std::is_nothrow_swappable_v<Container> && std::is_nothrow_swappable_v<Compare>) {
+		using std::swap;
+		swap(cont, rhs.cont);
+		swap(comp, rhs.comp);
+	}
+
+	ND const Container& Get_container() const noexcept {
+		return cont;
+	}
+
+protected:
+	Container cont;
+	Compare comp;
+
+private:
+	void sift_up(size_type i) {
+		dary_heap_detail::sift_up<Arity>(cont.begin(), i, comp, dary_heap_detail::No_tracking());
+	}
+
+	void heapify() {
+		dary_heap_detail::make_heap<Arity>(cont.begin(), cont.size(), comp, dary_heap_detail::No_tracking());
+	}
+};
+
+template <typename T, class Container, class Compare, size_t Arity>
+void swap(Priority_queue<T, Container, Compare, Arity>& lhs, Priority_queue<T, Container, Compare, Arity>& rhs)
+	noexcept(noexcept(lhs.swap(rhs))) {
+	lhs.swap(rhs);
+}
+
+
+// Priority queue whose elements can be reprioritised or removed after insertion: push returns a Handle that stays
+// valid, wherever the element moves in the heap, until that element is popped or erased. The heap holds the
+// elements themselves (so sifting compares neighbouring entries, not pointers) next to the handle slot they
+// belong to; a slot table maps each live handle to its current heap index. update() covers decrease-key and
+// increase-key in O(log_Arity n). Slots of removed elements are reused; each carries a generation, so a stale
+// handle is detected by contains() instead of silently naming a newer element.
+template <typename T, class Compare = std::less<T>, size_t Arity = 4>
+class Handle_priority_queue {
+	static_assert(Arity >= 2, "Handle_priority_queue needs an arity of at least 2");
+
+public:
+	using value_type		= T;
+	using value_compare		= Compare;
+	using size_type			= size_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+
+	static constexpr size_t arity = Arity;
+
+	class Handle {
+	public:
+		Handle() = default;
+
+		bool operator==(const Handle& other) const noexcept { return slot == other.slot && generation == other.generation; }
+		bool operator!=(const Handle& other) const noexcept { return !(*this == other); }
+
+	private:
+		friend class Handle_priority_queue;
+
+		Handle(std::uint32_t slot, std::uint32_t generation) : slot(slot), generation(generation) {}
+
+		std::uint32_t slot = std::uint32_t(-1);
+		std::uint32_t generation = 0;
+	};
+
+
+	Handle_priority_queue() = default;
+
+	explicit Handle_priority_queue(const Compare& comp) : comp(comp) {}
+
+
+	// Element access
+	const_reference top() const noexcept {
+		return heap.front().val;
+	}
+
+	ND Handle top_handle() const noexcept {
+		std::uint32_t s = heap.front().slot;
+		return Handle(s, slots[s].generation);
+	}
+
+	// The element h names. h must be valid
+	const_reference operator[](Handle h) const noexcept {
+		return heap[slots[h.slot].index].val;
+	}
+
+	// Whether h names an element still in the queue
+	ND bool contains(Handle h) const noexcept {
+		return h.slot < slots.size() && slots[h.slot].generation == h.generation && slots[h.slot].index != free_slot;
+	}
+
+
+	// Capacity
+	ND size_type size() const noexcept {
+		return heap.size();
+	}
+
+	ND bool empty() const noexcept {
+		return heap.empty();
+	}
+
+	void reserve(size_type n) {
+		heap.reserve(n);
+		slots.reserve(n);
+	}
+
+
+	// Modifiers
+	Handle push(const value_type& val) {
+		return emplace(val);
+	}
+
+	Handle push(value_type&& val) {
+		return emplace(std::move(val));
+	}
+
+	template<typename ... Args>
+	Handle emplace(Args&&... args) {
+		std::uint32_t s = acquire_slot();
+		try {
+			heap.push_back(Entry{ value_type(std::forward<Args>(args)...), s });
+		}
+		catch (...) {
+			release_slot(s);
+			throw;
+		}
+		Entry_compare c = entry_comp();
+		dary_heap_detail::sift_up<Arity>(heap.begin(), heap.size() - 1, c, Track{ slots.data() });
+		return Handle(s, slots[s].generation);
+	}
+
+	void pop() {
+		remove_at(0);
+	}
+
+	// Replaces the element h names and moves it up or down to its new place. h must be valid
+	void update(Handle h, const value_type& val) {
+		size_t i = slots[h.slot].index;
+		heap[i].val = val;
+		restore(i);
+	}
+
+	void update(Handle h, value_type&& val) {
+		size_t i = slots[h.slot].index;
+		heap[i].val = std::move(val);
+		restore(i);
+	}
+
+	// Removes the element h names. h must be valid
+	void erase(Handle h) {
+		remove_at(slots[h.slot].index);
+	}
+
+	void clear() noexcept {
+		for (const Entry& e : heap)
+			release_slot(e.slot);
+		heap.clear();
+	}
+
+	void swap(Handle_priority_queue& rhs) noexcept(std::is_nothrow_swappable_v<Compare>) {
+		using std::swap;
+		swap(heap, rhs.heap);
+		swap(slots, rhs.slots);
+		swap(free_head, rhs.free_head);
+		swap(comp, rhs.comp);
+	}
+
+private:
+	struct Entry {
+		value_type val;
+		std::uint32_t slot;
+	};
+
+	// index is the entry's heap position while live; a free slot keeps the next free slot in next_free
+	struct Slot {
+		size_t index;
+		std::uint32_t generation;
+		std::uint32_t next_free;
+	};
+
+	static constexpr size_t free_slot = size_t(-1);
+	static constexpr std::uint32_t no_slot = std::uint32_t(-1);
+
+	struct Track {
+		Slot* slots;
+		void operator()(const Entry& e, size_t i) const noexcept { slots[e.slot].index = i; }
+	};
+
+	struct Entry_compare {
+		Compare& comp;
+		bool operator()(const Entry& a, const Entry& b) const { return comp(a.val, b.val); }
+	};
+
+	Entry_compare entry_comp() { return Entry_compare{ comp }; }
+
+	std::uint32_t acquire_slot() {
+		if (free_head != no_slot) {
+			std::uint32_t s = free_head;
+			free_head = slots[s].next_free;
+			return s;
+		}
+		if (slots.size() >= no_slot)
+			throw std::length_error("Handle_priority_queue too large");
+		slots.push_back(Slot{ free_slot, 0, no_slot });
+		return static_cast<std::uint32_t>(slots.size() - 1);
+	}
+
+	void release_slot(std::uint32_t s) noexcept {
+		slots[s].index = free_slot;
+		++slots[s].generation;
+		slots[s].next_free = free_head;
+		free_head = s;
+	}
+
+	// Puts the entry at i back in heap order after its value changed
+	void restore(size_t i) {
+		Entry_compare c = entry_comp();
+		if (i > 0 && c(heap[(i - 1) / Arity], heap[i]))
+			dary_heap_detail::sift_up<Arity>(heap.begin(), i, c, Track{ slots.data() });
+		else
+			dary_heap_detail::sift_down<Arity>(heap.begin(), heap.size(), i, c, Track{ slots.data() });
+	}
+
+	void remove_at(size_t i) {
+		release_slot(heap[i].slot);
+		if (i + 1 < heap.size()) {
+			heap[i] = std::move(heap.back());
+			heap.pop_back();
+			restore(i);
+		}
+		else
+			heap.pop_back();
+	}
+
+	std::vector<Entry> heap;
+	std::vector<Slot> slots;
+	std::uint32_t free_head = no_slot;
+	Compare comp;
+};
+
+template <typename T, class Compare, size_t Arity>
+void swap(Handle_priority_queue<T, Compare, Arity>& lhs, Handle_priority_queue<T, Compare, Arity>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+	lhs.swap(rhs);
+}
+
+
+namespace pmr
+{
+	// Priority_queue over a std::vector drawing from a std::pmr::memory_resource
+	template <typename T, class Compare = std::less<T>, size_t Arity = 4>
+	using Priority_queue = ::Priority_queue<T, std::pmr::vector<T>, Compare, Arity>;
+}
+
+namespace std
+{
+	template <typename T, class Container, class Compare, size_t Arity, class Alloc>
+	struct uses_allocator<Priority_queue<T, Container, Compare, Arity>, Alloc> : uses_allocator<Container, Alloc>::type {};
+}
+
+
+#endif // !_Priority_Queue
@@ -0,0 +1,310 @@
+#ifndef _Blocking_Queue
+#define _Blocking_Queue
+
+#define ND [[nodiscard]]
+
+#include "MPMC_queue.h"
+#include "Queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define BLOCKING_QUEUE_COROUTINES
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+
+// MPMC_queue whose consumers can wait for an element: pop_wait() blocks, pop_for() blocks up to a timeout and,
+// in C++20, co_await q.pop() suspends a coroutine. A consumer that finds the queue empty first spins for a few
+// microseconds (the budget adapts to how often spinning pays off, and is zero on a single core), then parks.
+// Parking is an event count: push only touches the kernel when someone is parked, with a futex wake on Linux
+// and a condition variable elsewhere. A suspended coroutine is resumed on the thread whose push fed it.
+// Like MPMC_queue it is bounded; push spins while the ring is full. It must not be destroyed while anyone waits on it.
+// pop_wait() and co_await q.pop() move the element into a default-constructed T, so only they need that constructor.
+template <typename T>
+class Blocking_queue {
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+
+
+	// capacity is rounded up to a power of two
+	explicit Blocking_queue(size_type capacity = 1024) : items(capacity) {}
+
+	Blocking_queue(const Blocking_queue&) = delete;
+	Blocking_queue& operator=(const Blocking_queue&) = delete;
+
+
+	// Capacity
+	// Snapshots, like MPMC_queue's
+	ND size_type size() const noexcept {
+		return items.size();
+	}
+
+	ND bool empty() const noexcept {
+		return items.empty();
+	}
+
+	ND size_type capacity() const noexcept {
+		return items.capacity();
+	}
+
+
+	// Modifiers
+	void push(const value_type& val) {
+		emplace(val);
+	}
+
+	void push(value_type&& val) {
+		emplace(std::move(val));
+	}
+
+	template<typename ... Args>
+	void emplace(Args&&... args) {
+		items.emplace(std::forward<Args>(args)...);
+		wake_one();
+	}
+
+	// Moves the oldest element into out without waiting. Returns false if the queue was empty
+	ND bool try_pop(value_type& out) {
+		return items.try_pop(out);
+	}
+
+	// Waits as long as it takes for an element
+	value_type pop_wait() {
+		static_assert(std::is_default_constructible_v<T>, "Blocking_queue::pop_wait needs a default-constructible T");
+
+		value_type out;
+		if (items.try_pop(out) || spin_pop(out))
+			return out;
+
+		while (!park_pop(out, nullptr)) {}
+		return out;
+	}
+
+	// Waits up to timeout for an element. Returns false if none came
+	template <typename Rep, typename Period>
+	ND bool pop_for(value_type& out, const std::chrono::duration<Rep, Period>& timeout) {
+		if (items.try_pop(out))
+			return true;
+
+		auto deadline = std::chrono::steady_clock::now() + timeout;
+		if (spin_pop(out, deadline))
+			return true;
+
+		for (;;) {
+			auto now = std::chrono::steady_clock::now();
+			if (now >= deadline)
+				return items.try_pop(out);
+
+			auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+			if (park_pop(out, &left))
+				return true;
+		}
+	}
+
+#ifdef BLOCKING_QUEUE_COROUTINES
+	class Pop_awaiter {
+	public:
+		explicit Pop_awaiter(Blocking_queue& q) : q(q) {}
+
+		bool await_ready() {
+			return q.items.try_pop(value);
+		}
+
+		// Returns false, resuming at once, if an element turned up while registering
+		bool await_suspend(std::coroutine_handle<> h) {
+			handle = h;
+			std::lock_guard<std::mutex> lock(q.coro_m);
+			q.suspended.fetch_add(1, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (q.items.try_pop(value)) {
+				q.suspended.fetch_sub(1, std::memory_order_relaxed);
+				return false;
+			}
+			q.coro_waiters.push(this);
+			return true;
+		}
+
+		value_type await_resume() {
+			return std::move(value);
+		}
+
+	private:
+		friend class Blocking_queue;
+
+		Blocking_queue& q;
+		value_type value{};
+		std::coroutine_handle<> handle;
+	};
+
+	// co_await q.pop() yields the oldest element, suspending the coroutine while the queue is empty
+	ND Pop_awaiter pop() {
+		static_assert(std::is_default_constructible_v<T>, "co_await Blocking_queue::pop() needs a default-constructible T");
+
+		return Pop_awaiter(*this);
+	}
+#endif
+
+private:
+	static constexpr std::uint32_t min_spin_ns = 500;
+	static constexpr std::uint32_t max_spin_ns = 16000;
+
+	static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		_mm_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	// Retries for up to the spin budget (or until deadline). A success doubles the budget for next time,
+	// a miss halves it
+	bool spin_pop(value_type& out, std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+		if (single_core)
+			return false;
+
+		std::uint32_t budget = spin_ns.load(std::memory_order_relaxed);
+		auto start = std::chrono::steady_clock::now();
+		auto stop = std::min(deadline, start + std::chrono::nanoseconds(budget));
+
+		for (unsigned i = 1;; ++i) {
+			if (items.try_pop(out)) {
+				spin_ns.store(std::min(budget * 2, max_spin_ns), std::memory_order_relaxed);
+				return true;
+			}
+			cpu_relax();
+			if (i % 16 == 0 && std::chrono::steady_clock::now() >= stop)
+				break;
+		}
+
+		spin_ns.store(std::max(budget / 2, min_spin_ns), std::memory_order_relaxed);
+		return false;
+	}
+
+	// One round of parking: registers as a sleeper, re-checks the queue and sleeps until a push bumps epoch
+	// or timeout (nullptr: none) runs out. Returns true if it got an element
+	bool park_pop(value_type& out, const std::chrono::nanoseconds* timeout) {
+		sleepers.fetch_add(1, std::memory_order_seq_cst);
+		std::uint32_t seen = epoch.load(std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		bool got = items.try_pop(out);
+		if (!got) {
+			wait_for_epoch(seen, timeout);
+			got = items.try_pop(out);
+		}
+
+		sleepers.fetch_sub(1, std::memory_order_relaxed);
+		return got;
+	}
+
+	// After a push: hands the element to a suspended coroutine if there is one, otherwise wakes a parked thread.
+	// The fence pairs with the ones taken when registering, so either the waiter sees the element or we see it
+	void wake_one() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+#ifdef BLOCKING_QUEUE_COROUTINES
+		if (suspended.load(std::memory_order_relaxed) && resume_coroutine())
+			return;
+#endif
+
+		if (sleepers.load(std::memory_order_relaxed)) {
+			epoch.fetch_add(1, std::memory_order_seq_cst);
+			notify_epoch();
+		}
+	}
+
+#ifdef __linux__
+	static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex needs a plain 32-bit word");
+
+	void wait_for_epoch(std::uint32_t seen, const std::chrono::nanoseconds* timeout) {
+		timespec ts;
+		timespec* tsp = nullptr;
+		if (timeout) {
+			ts.tv_sec = static_cast<time_t>(timeout->count() / 1000000000);
+			ts.tv_nsec = static_cast<long>(timeout->count() % 1000000000);
+			tsp = &ts;
+		}
+		// Returns at once if epoch already moved on; spurious returns are fine, the caller re-checks
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch), FUTEX_WAIT_PRIVATE, seen, tsp, nullptr, 0);
+	}
+
+	void notify_epoch() {
+		syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+	}
+#else
+	void wait_for_epoch(std::uint32_t seen, const std::chrono::nanoseconds* timeout) {
+		std::unique_lock<std::mutex> lock(park_m);
+		auto moved = [&] { return epoch.load(std::memory_order_relaxed) != seen; };
+		if (timeout)
+			parked.wait_for(lock, *timeout, moved);
+		else
+			parked.wait(lock, moved);
+	}
+
+	void notify_epoch() {
+		std::lock_guard<std::mutex> lock(park_m);
+		parked.notify_one();
+	}
+#endif
+
+#ifdef BLOCKING_QUEUE_COROUTINES
+	// Pops an element straight into the oldest suspended coroutine and resumes it here, outside the lock
+	bool resume_coroutine() {
+		Pop_awaiter* w;
+		{
+			std::lock_guard<std::mutex> lock(coro_m);
+			if (coro_waiters.empty() || !items.try_pop(coro_waiters.front()->value))
+				return false;
+			w = coro_waiters.front();
+			coro_waiters.pop();
+			suspended.fetch_sub(1, std::memory_order_relaxed);
+		}
+		w->handle.resume();
+		return true;
+	}
+#endif
+
+	MPMC_queue<T> items;
+	const bool single_core = std::thread::hardware_concurrency() <= 1;
+	std::atomic<std::uint32_t> spin_ns{ 2000 };
+
+	alignas(MPMC_queue<T>::cache_line) std::atomic<std::uint32_t> epoch{ 0 };
+	std::atomic<std::uint32_t> sleepers{ 0 };
+#ifndef __linux__
+	std::mutex park_m;
+	std::condition_variable parked;
+#endif
+
+#ifdef BLOCKING_QUEUE_COROUTINES
+	std::atomic<std::uint32_t> suspended{ 0 };
+	std::mutex coro_m;
+	Queue<Pop_awaiter*> coro_waiters;
+#endif
+};
+
+
+#endif // !_Blocking_Queue
@@ -0,0 +1,204 @@
+#ifndef _MPMC_Queue
+#define _MPMC_Queue
+
+#define ND [[nodiscard]]
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <stdexcept>
+
+
+// Bounded lock-free multi-producer/multi-consumer queue (D. Vyukov's ring with per-cell sequence numbers).
+// Keeps Queue's push/emplace vocabulary, but consuming is try_pop(value_type&): front() followed by pop()
+// cannot be made safe when other threads consume concurrently.
+// push/emplace spin (yielding) while the ring is full, try_push/try_emplace fail instead.
+// Exceptions from T leave the queue usable: a construction that throws publishes its cell empty and consumers
+// skip it, and an element whose move into try_pop's out throws is destroyed and its cell released.
+template <typename T>
+class MPMC_queue {
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+
+	static constexpr size_type cache_line = 64;
+
+
+	// capacity is rounded up to a power of two
+	explicit MPMC_queue(size_type capacity = 1024) : mask(round_up_pow2(capacity) - 1), cells(new Cell[mask + 1]) {
+		for (size_type i = 0; i <= mask; ++i)
+			cells[i].seq.store(i, std::memory_order_relaxed);
+	}
+
+	MPMC_queue(const MPMC_queue&) = delete;
+	MPMC_queue& operator=(const MPMC_queue&) = delete;
+
+	~MPMC_queue() {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			while (try_pop_impl([](T&) {})) {}
+		}
+	}
+
+
+	// Capacity
+	// Both are snapshots: other threads may change the queue before the caller looks at the result.
+	// They also count cells left empty by a throwing construction until a pop skips them
+	ND size_type size() const noexcept {
+		size_type tail = enqueue_pos.load(std::memory_order_acquire);
+		size_type head = dequeue_pos.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+	ND bool empty() const noexcept {
+		return size() == 0;
+	}
+
+	ND size_type capacity() const noexcept {
+		return mask + 1;
+	}
+
+
+	// Modifiers
+	void push(const value_type& val) {
+		emplace(val);
+	}
+
+	void push(value_type&& val) {
+		emplace(std::move(val));
+	}
+
+	template<typename ... Args>
+	void emplace(Args&&... args) {
+		while (!try_emplace(std::forward<Args>(args)...))
+			std::this_thread::yield();
+	}
+
+	ND bool try_push(const value_type& val) {
+		return try_emplace(val);
+	}
+
+	ND bool try_push(value_type&& val) {
+		return try_emplace(std::move(val));
+	}
+
+	template<typename ... Args>
+	ND bool try_emplace(Args&&... args) {
+		Cell* cell;
+		size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_type seq = cell->seq.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+			if (diff == 0) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		// The cell is claimed, so it is published even when construction throws, or every later lap would wait on it
+		try {
+			::new (static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			cell->filled = false;
+			cell->seq.store(pos + 1, std::memory_order_release);
+			throw;
+		}
+		cell->filled = true;
+		cell->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Moves the oldest element into out. Returns false if the queue was empty
+	ND bool try_pop(value_type& out) {
+		return try_pop_impl([&out](T& val) { out = std::move(val); });
+	}
+
+	// Removes the oldest element without reading it. Returns false if the queue was empty
+	bool pop() {
+		return try_pop_impl([](T&) {});
+	}
+
+private:
+	struct alignas(cache_line) Cell {
+		std::atomic<size_type> seq;
+		bool filled = false;	// false when the producer's construction threw, written before seq publishes the cell
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+	};
+
+	static size_type round_up_pow2(size_type n) {
+		if (n < 2) return 2;
+		size_type p = 1;
+		while (p < n) {
+			if (p > (size_type(-1) >> 1))
+				throw std::length_error("MPMC_queue capacity too large");
+			p <<= 1;
+		}
+		return p;
+	}
+
+	// Cells left empty by a throwing construction are released and skipped. The claimed cell is released
+	// even when consume throws
+	template <typename F>
+	bool try_pop_impl(F&& consume) {
+		Cell* cell;
+		size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_type seq = cell->seq.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+			if (diff == 0) {
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					if (cell->filled)
+						break;
+					cell->seq.store(pos + mask + 1, std::memory_order_release);
+					pos = dequeue_pos.load(std::memory_order_relaxed);
+				}
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+
+		T* val = cell->value();
+		try {
+			consume(*val);
+		}
+		catch (...) {
+			val->~T();
+			cell->seq.store(pos + mask + 1, std::memory_order_release);
+			throw;
+		}
+		val->~T();
+		cell->seq.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	const size_type mask;
+	std::unique_ptr<Cell[]> cells;
+	alignas(cache_line) std::atomic<size_type> enqueue_pos{ 0 };
+	alignas(cache_line) std::atomic<size_type> dequeue_pos{ 0 };
+};
+
+
+#endif // !_MPMC_Queue
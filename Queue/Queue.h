@@ -4,12 +4,21 @@
 #define ND [[nodiscard]]
 
 #include <deque>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+#include "../Adapters/Adapter_traits.h"
+#include "../Instrumentation/Container_stats.h"
 
 
 template <typename T, class Container = std::deque<T>>
 class Queue {
 public:
-	using container_type	= typename Container;
+	using container_type	= Container;
 	using value_type		= typename Container::value_type;
 	using size_type			= typename Container::size_type;
 	using reference			= typename Container::reference;
@@ -26,6 +35,23 @@ public:
 
 	explicit Queue(Container&& cont) noexcept(std::is_nothrow_move_constructible_v<Container>) : cont(std::move(cont)) {}
 
+	// Allocator-extended constructors. With the std::uses_allocator specialisation below, a Queue stored in a
+	// scoped-allocator or pmr container is built with that container's allocator through these
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	explicit Queue(const Alloc& alloc) : cont(alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Queue(const Container& cont, const Alloc& alloc) : cont(cont, alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Queue(Container&& cont, const Alloc& alloc) : cont(std::move(cont), alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Queue(const Queue& q, const Alloc& alloc) : cont(q.cont, alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Queue(Queue&& q, const Alloc& alloc) : cont(std::move(q.cont), alloc) {}
+
 	Queue& operator=(const Queue& q) { 
 		cont = q.cont; 
 		return *this;
@@ -67,33 +93,114 @@ public:
 
 	// Modifiers
 	void push(const value_type& val) { 
+		CONTAINER_STATS_COUNT(pushes, 1);
 		cont.push_back(val); 
 	}
 
 	void push(value_type&& val) { 
+		CONTAINER_STATS_COUNT(pushes, 1);
 		cont.push_back(std::move(val)); 
 	}
 
 	template<typename ... Args>
 	void emplace(Args&&... args) { 
+		CONTAINER_STATS_COUNT(pushes, 1);
 		cont.emplace_back(std::forward<Args>(args)...);
 	}
 
 	void pop() noexcept(noexcept(cont.pop_front())) { 
+		CONTAINER_STATS_COUNT(pops, 1);
 		cont.pop_front(); 
 	}
 
+	// Pushes [first, last) in order, the first element is popped first
+	template <class InputIt>
+	void push_range(InputIt first, InputIt last) {
+#ifdef CONTAINER_STATS
+		size_type before = cont.size();
+#endif
+		if constexpr (adapter_detail::has_range_insert<Container, InputIt>::value) {
+			cont.insert(cont.end(), first, last);
+		}
+		else {
+			for (; first != last; ++first)
+				cont.push_back(*first);
+		}
+		CONTAINER_STATS_COUNT(pushes, cont.size() - before);
+	}
+
+	// Pops up to n elements into out, oldest first. Returns the end of the written range
+	template <class OutputIt>
+	OutputIt pop_n(OutputIt out, size_type n) {
+		n = std::min(n, cont.size());
+		if (n == 0) return out;
+		CONTAINER_STATS_COUNT(pops, n);
+
+		if constexpr (adapter_detail::raw_copy<Container, OutputIt>) {
+			std::memcpy(out, cont.data(), n * sizeof(value_type));
+			cont.erase(cont.begin(), cont.begin() + n);
+			return out + n;
+		}
+		else if constexpr (adapter_detail::has_range_erase<Container>::value) {
+			out = std::move(cont.begin(), cont.begin() + n, out);
+			cont.erase(cont.begin(), cont.begin() + n);
+			return out;
+		}
+		else {
+			for (; n; --n) {
+				*out++ = std::move(cont.front());
+				cont.pop_front();
+			}
+			return out;
+		}
+	}
+
+	// Pops every element into out, oldest first
+	template <class OutputIt>
+	OutputIt drain(OutputIt out) {
+		return pop_n(out, cont.size());
+	}
+
 	void swap(Queue& rhs) noexcept(std::is_nothrow_swappable_v<Container>) { 
-		cont.swap(rhs);
+		cont.swap(rhs.cont);
 	}
 
 	ND const Container& Get_container() const noexcept {
 		return cont;
 	}
 
+	// Pushes and pops under CONTAINER_STATS (see Instrumentation/Container_stats.h). The allocation numbers stay zero
+	// unless the container allocates through a Counting_allocator, as std::deque<T, Counting_allocator<T>> does;
+	// a Ring_buffer never allocates
+	ND Container_stats stats() const {
+		Container_stats s;
+		stats_detail::add_container_allocations(s, cont);
+#ifdef CONTAINER_STATS
+		stats_detail::add_operations(s, op_stats);
+#endif
+		return s;
+	}
+
 protected:
 	Container cont;
+#ifdef CONTAINER_STATS
+	Operation_counters op_stats;
+#endif
 };
 
 
+namespace pmr
+{
+	// Queue over a std::deque drawing from a std::pmr::memory_resource
+	template <typename T>
+	using Queue = ::Queue<T, std::pmr::deque<T>>;
+}
+
+namespace std
+{
+	template <typename T, class Container, class Alloc>
+	struct uses_allocator<Queue<T, Container>, Alloc> : uses_allocator<Container, Alloc>::type {};
+}
+
+
 #endif // !_Queue
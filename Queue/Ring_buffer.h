@@ -0,0 +1,203 @@
+#ifndef _Ring_Buffer
+#define _Ring_Buffer
+
+#define ND [[nodiscard]]
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+// Fixed-capacity FIFO storage for up to N elements (N a power of two), kept inline: no allocation ever.
+// Provides the sequence interface Queue needs, so Queue<T, Ring_buffer<T, N>> works as is.
+//
+// One producer thread (push_back/emplace_back/back) and one consumer thread (front/pop_front) may use it
+// concurrently without locks: each side owns one index on its own cache line and publishes it with a
+// release store, every operation finishes in a bounded number of steps. size() and empty() are exact for
+// the calling side's own changes and snapshots otherwise. Copying, moving and swap need exclusive access.
+template <typename T, size_t N>
+class Ring_buffer {
+	static_assert(N > 0 && (N & (N - 1)) == 0, "Ring_buffer capacity must be a power of two");
+
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using difference_type	= std::ptrdiff_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+
+	static constexpr size_type cache_line = 64;
+
+
+	Ring_buffer() = default;
+
+	Ring_buffer(const Ring_buffer& other) {
+		for (size_type i = other.first(); i != other.last(); ++i)
+			emplace_back(*other.slot(i));
+	}
+
+	Ring_buffer(Ring_buffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		for (size_type i = other.first(); i != other.last(); ++i)
+			emplace_back(std::move(*other.slot(i)));
+		other.clear();
+	}
+
+	Ring_buffer& operator=(const Ring_buffer& other) {
+		if (this != &other) {
+			clear();
+			for (size_type i = other.first(); i != other.last(); ++i)
+				emplace_back(*other.slot(i));
+		}
+		return *this;
+	}
+
+	Ring_buffer& operator=(Ring_buffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (this != &other) {
+			clear();
+			for (size_type i = other.first(); i != other.last(); ++i)
+				emplace_back(std::move(*other.slot(i)));
+			other.clear();
+		}
+		return *this;
+	}
+
+	~Ring_buffer() { clear(); }
+
+
+	// Element access
+	// front() belongs to the consumer, back() to the producer. Both require a non-empty buffer
+	ND reference front() noexcept { return *slot(first()); }
+
+	ND const_reference front() const noexcept { return *slot(first()); }
+
+	ND reference back() noexcept { return *slot(last() - 1); }
+
+	ND const_reference back() const noexcept { return *slot(last() - 1); }
+
+
+	// Capacity
+	ND size_type size() const noexcept {
+		size_type h = head.load(std::memory_order_acquire);
+		return tail.load(std::memory_order_acquire) - h;
+	}
+
+	ND bool empty() const noexcept { return size() == 0; }
+
+	ND bool full() const noexcept { return size() == N; }
+
+	ND static constexpr size_type capacity() noexcept { return N; }
+
+	ND static constexpr size_type max_size() noexcept { return N; }
+
+
+	// Modifiers
+	void push_back(const value_type& val) {
+		emplace_back(val);
+	}
+
+	void push_back(value_type&& val) {
+		emplace_back(std::move(val));
+	}
+
+	// Throws std::length_error when the buffer is full; try_emplace_back reports it instead
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		T* p = try_emplace_back(std::forward<Args>(args)...);
+		if (!p)
+			throw std::length_error("Ring_buffer is full");
+		return *p;
+	}
+
+	ND bool try_push_back(const value_type& val) {
+		return try_emplace_back(val) != nullptr;
+	}
+
+	ND bool try_push_back(value_type&& val) {
+		return try_emplace_back(std::move(val)) != nullptr;
+	}
+
+	// Returns the new element, or nullptr if the buffer is full
+	template <class... Args>
+	T* try_emplace_back(Args&&... args) {
+		size_type t = tail.load(std::memory_order_relaxed);
+		if (t - cached_head == N) {
+			cached_head = head.load(std::memory_order_acquire);
+			if (t - cached_head == N)
+				return nullptr;
+		}
+
+		T* p = ::new (static_cast<void*>(slot_storage(t))) T(std::forward<Args>(args)...);
+		tail.store(t + 1, std::memory_order_release);
+		return p;
+	}
+
+	void pop_front() noexcept {
+		size_type h = head.load(std::memory_order_relaxed);
+		slot(h)->~T();
+		head.store(h + 1, std::memory_order_release);
+	}
+
+	// Consumer side: moves the oldest element into out. Returns false if the buffer is empty
+	ND bool try_pop_front(value_type& out) {
+		// pop_front and clear advance head without looking at tail, so cached_tail may be behind head, not just equal
+		size_type h = head.load(std::memory_order_relaxed);
+		if (static_cast<difference_type>(cached_tail - h) <= 0) {
+			cached_tail = tail.load(std::memory_order_acquire);
+			if (cached_tail == h)
+				return false;
+		}
+
+		out = std::move(*slot(h));
+		slot(h)->~T();
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	void clear() noexcept {
+		while (first() != last())
+			pop_front();
+	}
+
+	void swap(Ring_buffer& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		Ring_buffer tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+private:
+	size_type first() const noexcept { return head.load(std::memory_order_acquire); }
+
+	size_type last() const noexcept { return tail.load(std::memory_order_acquire); }
+
+	void* slot_storage(size_type i) noexcept {
+		return storage + (i & (N - 1)) * sizeof(T);
+	}
+
+	T* slot(size_type i) noexcept {
+		return std::launder(reinterpret_cast<T*>(storage + (i & (N - 1)) * sizeof(T)));
+	}
+
+	const T* slot(size_type i) const noexcept {
+		return std::launder(reinterpret_cast<const T*>(storage + (i & (N - 1)) * sizeof(T)));
+	}
+
+	// Producer line: its index plus the last consumer index it has seen
+	alignas(cache_line) std::atomic<size_type> tail{ 0 };
+	size_type cached_head = 0;
+
+	// Consumer line: its index plus the last producer index it has seen
+	alignas(cache_line) std::atomic<size_type> head{ 0 };
+	size_type cached_tail = 0;
+
+	alignas(cache_line) alignas(T) unsigned char storage[N * sizeof(T)];
+};
+
+template <typename T, size_t N>
+void swap(Ring_buffer<T, N>& lhs, Ring_buffer<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+	lhs.swap(rhs);
+}
+
+
+#endif // !_Ring_Buffer
@@ -0,0 +1,336 @@
+#ifndef _Small_Vector
+#define _Small_Vector
+
+#define ND [[nodiscard]]
+
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+// Vector that keeps its first N elements inside the object and only goes to the allocator once it grows
+// past them. Usable as Stack<T, Small_vector<T, N>>: stacks that stay within N elements never allocate.
+// Iterators are plain pointers; like std::vector, growing invalidates them.
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
+class Small_vector {
+	static_assert(N > 0, "Small_vector needs at least one inline element");
+
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using difference_type	= std::ptrdiff_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+	using allocator_type	= Allocator;
+	using pointer			= T*;
+	using const_pointer		= const T*;
+	using iterator			= T*;
+	using const_iterator	= const T*;
+
+	static constexpr size_type inline_capacity = N;
+
+
+	Small_vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) {}
+
+	explicit Small_vector(const Allocator& alloc) noexcept : alloc(alloc) {}
+
+	Small_vector(std::initializer_list<T> init, const Allocator& alloc = Allocator()) : alloc(alloc) {
+		insert(end(), init.begin(), init.end());
+	}
+
+	Small_vector(const Small_vector& other)
+		: alloc(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc)) {
+		insert(end(), other.begin(), other.end());
+	}
+
+	Small_vector(Small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : alloc(std::move(other.alloc)) {
+		take(other);
+	}
+
+	~Small_vector() {
+		clear();
+		release();
+	}
+
+	Small_vector& operator=(const Small_vector& other) {
+		if (this == &other)
+			return *this;
+
+		clear();
+		if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+			if (alloc != other.alloc) {
+				release();
+				alloc = other.alloc;
+			}
+		}
+		insert(end(), other.begin(), other.end());
+		return *this;
+	}
+
+	Small_vector& operator=(Small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (this == &other)
+			return *this;
+
+		clear();
+		if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || alloc == other.alloc) {
+			release();
+			if constexpr (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value)
+				alloc = std::move(other.alloc);
+			take(other);
+		}
+		else {
+			for (T& x : other)
+				emplace_back(std::move(x));
+			other.clear();
+		}
+		return *this;
+	}
+
+	allocator_type get_allocator() const { return alloc; }
+
+
+	// Iterators
+	ND iterator begin() noexcept { return first; }
+
+	ND iterator end() noexcept { return first + sz; }
+
+	ND const_iterator begin() const noexcept { return first; }
+
+	ND const_iterator end() const noexcept { return first + sz; }
+
+	ND const_iterator cbegin() const noexcept { return first; }
+
+	ND const_iterator cend() const noexcept { return first + sz; }
+
+
+	// Element access
+	ND reference operator[](size_type i) noexcept { return first[i]; }
+
+	ND const_reference operator[](size_type i) const noexcept { return first[i]; }
+
+	ND reference front() noexcept { return first[0]; }
+
+	ND const_reference front() const noexcept { return first[0]; }
+
+	ND reference back() noexcept { return first[sz - 1]; }
+
+	ND const_reference back() const noexcept { return first[sz - 1]; }
+
+	ND T* data() noexcept { return first; }
+
+	ND const T* data() const noexcept { return first; }
+
+
+	// Capacity
+	ND bool empty() const noexcept { return sz == 0; }
+
+	ND size_type size() const noexcept { return sz; }
+
+	ND size_type capacity() const noexcept { return cap; }
+
+	// True while the elements live in the object itself
+	ND bool is_inline() const noexcept { return first == inline_data(); }
+
+	void reserve(size_type n) {
+		if (n > cap)
+			relocate(n);
+	}
+
+
+	// Modifiers
+	void clear() noexcept {
+		destroy(first, first + sz);
+		sz = 0;
+	}
+
+	void push_back(const T& val) {
+		emplace_back(val);
+	}
+
+	void push_back(T&& val) {
+		emplace_back(std::move(val));
+	}
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		if (sz == cap) {
+			// The new element may alias an existing one, so it is built before the old buffer goes away
+			size_type new_cap = grown(sz + 1);
+			T* buf = std::allocator_traits<Allocator>::allocate(alloc, new_cap);
+			try {
+				std::allocator_traits<Allocator>::construct(alloc, buf + sz, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				std::allocator_traits<Allocator>::deallocate(alloc, buf, new_cap);
+				throw;
+			}
+
+			try {
+				move_into(buf, new_cap);
+			}
+			catch (...) {
+				destroy(buf + sz, buf + sz + 1);
+				std::allocator_traits<Allocator>::deallocate(alloc, buf, new_cap);
+				throw;
+			}
+		}
+		else {
+			std::allocator_traits<Allocator>::construct(alloc, first + sz, std::forward<Args>(args)...);
+		}
+
+		return first[sz++];
+	}
+
+	void pop_back() noexcept {
+		--sz;
+		destroy(first + sz, first + sz + 1);
+	}
+
+	template<class InputIt, typename std::enable_if_t<
+	std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>, int> = 0>
+	iterator insert(const_iterator pos, InputIt from, InputIt to) {
+		size_type offset = pos - first;
+		size_type old_size = sz;
+
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+			reserve(sz + static_cast<size_type>(std::distance(from, to)));
+
+		for (; from != to; ++from)
+			emplace_back(*from);
+
+		std::rotate(first + offset, first + old_size, first + sz);
+		return first + offset;
+	}
+
+	iterator erase(const_iterator from, const_iterator to) {
+		T* f = const_cast<T*>(from);
+		T* t = const_cast<T*>(to);
+		if (f == t) return f;
+
+		T* new_end = std::move(t, end(), f);
+		destroy(new_end, end());
+		sz = new_end - first;
+		return f;
+	}
+
+	iterator erase(const_iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	void swap(Small_vector& other) {
+		if (this == &other) return;
+
+		if (!is_inline() && !other.is_inline()) {
+			if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value)
+				std::swap(alloc, other.alloc);
+			std::swap(first, other.first);
+			std::swap(sz, other.sz);
+			std::swap(cap, other.cap);
+			return;
+		}
+
+		Small_vector tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+private:
+	T* inline_data() noexcept { return reinterpret_cast<T*>(buffer); }
+
+	const T* inline_data() const noexcept { return reinterpret_cast<const T*>(buffer); }
+
+	size_type grown(size_type needed) const noexcept {
+		return std::max(needed, cap * 2);
+	}
+
+	void destroy(T* from, T* to) noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (; from != to; ++from)
+				std::allocator_traits<Allocator>::destroy(alloc, from);
+		}
+	}
+
+	// Hands the heap buffer back, if there is one, and returns to the inline storage. Elements must be gone
+	void release() noexcept {
+		if (!is_inline())
+			std::allocator_traits<Allocator>::deallocate(alloc, first, cap);
+		first = inline_data();
+		cap = N;
+	}
+
+	// Moves the current elements into buf (capacity new_cap) and makes it the storage.
+	// If a copy throws, buf is left without elements and the vector is unchanged
+	void move_into(T* buf, size_type new_cap) {
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			if (sz)
+				std::memcpy(static_cast<void*>(buf), static_cast<const void*>(first), sz * sizeof(T));
+		}
+		else {
+			size_type i = 0;
+			try {
+				for (; i < sz; ++i)
+					std::allocator_traits<Allocator>::construct(alloc, buf + i, std::move_if_noexcept(first[i]));
+			}
+			catch (...) {
+				destroy(buf, buf + i);
+				throw;
+			}
+			destroy(first, first + sz);
+		}
+
+		size_type n = sz;
+		release();
+		first = buf;
+		cap = new_cap;
+		sz = n;
+	}
+
+	void relocate(size_type new_cap) {
+		T* buf = std::allocator_traits<Allocator>::allocate(alloc, new_cap);
+		try {
+			move_into(buf, new_cap);
+		}
+		catch (...) {
+			std::allocator_traits<Allocator>::deallocate(alloc, buf, new_cap);
+			throw;
+		}
+	}
+
+	// Takes other's elements: steals a heap buffer, moves inline elements one by one
+	void take(Small_vector& other) {
+		if (!other.is_inline()) {
+			first = other.first;
+			cap = other.cap;
+			sz = other.sz;
+			other.first = other.inline_data();
+			other.cap = N;
+			other.sz = 0;
+			return;
+		}
+
+		for (size_type i = 0; i < other.sz; ++i)
+			std::allocator_traits<Allocator>::construct(alloc, first + i, std::move(other.first[i]));
+		sz = other.sz;
+		other.clear();
+	}
+
+	Allocator alloc;
+	T* first = inline_data();
+	size_type sz = 0;
+	size_type cap = N;
+	alignas(T) unsigned char buffer[N * sizeof(T)];
+};
+
+template <typename T, size_t N, typename Allocator>
+void swap(Small_vector<T, N, Allocator>& lhs, Small_vector<T, N, Allocator>& rhs) {
+	lhs.swap(rhs);
+}
+
+
+#endif // !_Small_Vector
@@ -4,6 +4,15 @@
 #define ND [[nodiscard]]
 
 #include <deque>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+#include "../Adapters/Adapter_traits.h"
+#include "../Instrumentation/Container_stats.h"
 
 template<typename T, class Container = std::deque<T>> 
 class Stack {
@@ -18,10 +27,10 @@ public:
 
 	Stack() = default;
 
-	Stack(const Stack<T>& s) noexcept(std::is_nothrow_copy_constructible_v<Container>) 
+	Stack(const Stack& s) noexcept(std::is_nothrow_copy_constructible_v<Container>) 
 		: cont(s.cont) {}
 
-	Stack(Stack<T>&& s) noexcept(std::is_nothrow_move_constructible_v<Container>) 
+	Stack(Stack&& s) noexcept(std::is_nothrow_move_constructible_v<Container>) 
 		: cont(std::move(s.cont)) {}
 
 	explicit Stack(const Container& cont) noexcept(std::is_nothrow_copy_constructible_v<Container>) 
@@ -30,13 +39,30 @@ public:
 	explicit Stack(Container&& cont) noexcept(std::is_nothrow_move_constructible_v<Container>) 
 		: cont(std::move(cont)) {}
 
+	// Allocator-extended constructors: alloc is handed to the container, so a pmr::Stack's deque draws from
+	// the caller's memory resource
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	explicit Stack(const Alloc& alloc) : cont(alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Stack(const Container& cont, const Alloc& alloc) : cont(cont, alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Stack(Container&& cont, const Alloc& alloc) : cont(std::move(cont), alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Stack(const Stack& s, const Alloc& alloc) : cont(s.cont, alloc) {}
+
+	template <class Alloc, typename = std::enable_if_t<std::uses_allocator_v<Container, Alloc>>>
+	Stack(Stack&& s, const Alloc& alloc) : cont(std::move(s.cont), alloc) {}
+
 	Stack& operator=(const Stack& rhs) & noexcept(std::is_nothrow_assignable_v<Container>) {
 		cont = rhs.cont;
 		return *this;
 	}
 
 	Stack& operator=(Stack&& rhs) & noexcept(std::is_nothrow_move_assignable_v<Container>) {
-		cont = std::move(rhs);
+		cont = std::move(rhs.cont);
 		return *this;
 	}
 
@@ -60,22 +86,77 @@ public:
 
 	// Modifiers
 	void push(const value_type& val) { 
+		CONTAINER_STATS_COUNT(pushes, 1);
 		cont.push_back(val);
 	}
 
 	void push(value_type&& val) { 
+		CONTAINER_STATS_COUNT(pushes, 1);
 		cont.push_back(std::move(val));
 	}
 
 	template< class... Args >
 	void emplace(Args&&... args) { 
+		CONTAINER_STATS_COUNT(pushes, 1);
 		cont.emplace_back(std::forward<Args>(args)...); 
 	}
 
 	void pop() noexcept(noexcept(this->cont.pop_back())) {
+		CONTAINER_STATS_COUNT(pops, 1);
 		cont.pop_back();
 	}
 
+	// Pushes [first, last) in order, so the last element ends up on top
+	template <class InputIt>
+	void push_range(InputIt first, InputIt last) {
+#ifdef CONTAINER_STATS
+		size_type before = cont.size();
+#endif
+		if constexpr (adapter_detail::has_range_insert<Container, InputIt>::value) {
+			cont.insert(cont.end(), first, last);
+		}
+		else {
+			for (; first != last; ++first)
+				cont.push_back(*first);
+		}
+		CONTAINER_STATS_COUNT(pushes, cont.size() - before);
+	}
+
+	// Pops up to n elements into out, top first, i.e. in the order repeated pop() calls would see them.
+	// Returns the end of the written range
+	template <class OutputIt>
+	OutputIt pop_n(OutputIt out, size_type n) {
+		n = std::min(n, cont.size());
+		if (n == 0) return out;
+		CONTAINER_STATS_COUNT(pops, n);
+
+		if constexpr (adapter_detail::raw_copy<Container, OutputIt>) {
+			std::memcpy(out, cont.data() + (cont.size() - n), n * sizeof(value_type));
+			std::reverse(out, out + n);
+			cont.erase(cont.end() - n, cont.end());
+			return out + n;
+		}
+		else if constexpr (adapter_detail::has_range_erase<Container>::value) {
+			auto first = cont.end() - n;
+			out = std::move(std::make_reverse_iterator(cont.end()), std::make_reverse_iterator(first), out);
+			cont.erase(first, cont.end());
+			return out;
+		}
+		else {
+			for (; n; --n) {
+				*out++ = std::move(cont.back());
+				cont.pop_back();
+			}
+			return out;
+		}
+	}
+
+	// Pops every element into out, top first
+	template <class OutputIt>
+	OutputIt drain(OutputIt out) {
+		return pop_n(out, cont.size());
+	}
+
 	void swap(Stack& rhs) noexcept(std::is_nothrow_swappable_v<Container>) { 
 		std::swap(cont, rhs.cont); 
 	}
@@ -84,8 +165,22 @@ public:
 		return cont; 
 	}
 
+	// Pushes and pops, push_range and pop_n counted per element, when built with CONTAINER_STATS; allocations when
+	// the container allocates through a Counting_allocator, e.g. Stack<T, std::vector<T, Counting_allocator<T>>>
+	ND Container_stats stats() const {
+		Container_stats s;
+		stats_detail::add_container_allocations(s, cont);
+#ifdef CONTAINER_STATS
+		stats_detail::add_operations(s, op_stats);
+#endif
+		return s;
+	}
+
 protected:
 	Container cont;	
+#ifdef CONTAINER_STATS
+	Operation_counters op_stats;
+#endif
 };
 
 template <typename T, class Container>
@@ -94,4 +189,18 @@ void swap(Stack<T, Container>& lhs, Stack<T, Container>& rhs) noexcept(std::is_n
 }
 
 
+namespace pmr
+{
+	// Stack over a std::deque drawing from a std::pmr::memory_resource
+	template <typename T>
+	using Stack = ::Stack<T, std::pmr::deque<T>>;
+}
+
+namespace std
+{
+	template <typename T, class Container, class Alloc>
+	struct uses_allocator<Stack<T, Container>, Alloc> : uses_allocator<Container, Alloc>::type {};
+}
+
+
 #endif // _Stack
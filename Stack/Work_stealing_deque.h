@@ -0,0 +1,167 @@
+#ifndef _Work_Stealing_Deque
+#define _Work_Stealing_Deque
+
+#define ND [[nodiscard]]
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+// Chase-Lev work-stealing deque (with the memory orderings of Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013).
+// One owner thread uses the bottom like a Stack: push and try_pop, LIFO. Any number of thieves call try_steal
+// concurrently and take the oldest element from the top, lock-free. The ring grows when full; a replaced ring
+// may still be read by a thief that loaded it before the swap, so it is kept until the deque is destroyed.
+// The retired rings add up to less than the current one.
+// Elements are copied in and out of atomic slots, so T must be trivially copyable: typically a task pointer.
+template <typename T>
+class Work_stealing_deque {
+	static_assert(std::is_trivially_copyable_v<T>, "Work_stealing_deque elements must be trivially copyable");
+
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+
+	static constexpr size_type cache_line = 64;
+
+
+	// capacity is rounded up to a power of two
+	explicit Work_stealing_deque(size_type capacity = 256) : ring(new Ring(round_up_pow2(capacity))) {}
+
+	Work_stealing_deque(const Work_stealing_deque&) = delete;
+	Work_stealing_deque& operator=(const Work_stealing_deque&) = delete;
+
+	~Work_stealing_deque() {
+		delete ring.load(std::memory_order_relaxed);
+	}
+
+
+	// Capacity
+	// Both are snapshots: other threads may change the deque before the caller looks at the result
+	ND size_type size() const noexcept {
+		std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+		return b > t ? static_cast<size_type>(b - t) : 0;
+	}
+
+	ND bool empty() const noexcept {
+		return size() == 0;
+	}
+
+	ND size_type capacity() const noexcept {
+		return ring.load(std::memory_order_relaxed)->mask + 1;
+	}
+
+
+	// Owner side
+	void push(const value_type& val) {
+		std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+		std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		Ring* r = ring.load(std::memory_order_relaxed);
+
+		if (b - t > static_cast<std::ptrdiff_t>(r->mask))
+			r = grow(r, t, b);
+
+		r->put(b, val);
+		bottom.store(b + 1, std::memory_order_release);
+	}
+
+	// Moves the newest element into out. Returns false if the deque was empty
+	ND bool try_pop(value_type& out) noexcept {
+		std::ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Ring* r = ring.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		out = r->get(b);
+		if (t == b) {
+			// Last element: race the thieves for it
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+
+	// Thief side
+	// Moves the oldest element into out. Returns false if the deque was empty or another thread took
+	// the element first; the caller decides whether to retry or try another deque
+	ND bool try_steal(value_type& out) noexcept {
+		std::ptrdiff_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+			return false;
+
+		Ring* r = ring.load(std::memory_order_acquire);
+		value_type val = r->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false;
+
+		out = val;
+		return true;
+	}
+
+private:
+	struct Ring {
+		const size_type mask;
+		std::unique_ptr<std::atomic<T>[]> slots;
+
+		explicit Ring(size_type capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+		void put(std::ptrdiff_t i, const T& val) noexcept {
+			slots[static_cast<size_type>(i) & mask].store(val, std::memory_order_relaxed);
+		}
+
+		T get(std::ptrdiff_t i) const noexcept {
+			return slots[static_cast<size_type>(i) & mask].load(std::memory_order_relaxed);
+		}
+	};
+
+	static size_type round_up_pow2(size_type n) {
+		if (n < 2) return 2;
+		size_type p = 1;
+		while (p < n) {
+			if (p > (size_type(-1) >> 1))
+				throw std::length_error("Work_stealing_deque capacity too large");
+			p <<= 1;
+		}
+		return p;
+	}
+
+	// Owner only: copies the live range [t, b) into a ring twice as large and publishes it
+	Ring* grow(Ring* old, std::ptrdiff_t t, std::ptrdiff_t b) {
+		if (old->mask + 1 > (size_type(-1) >> 1))
+			throw std::length_error("Work_stealing_deque capacity too large");
+
+		retired.reserve(retired.size() + 1);
+		std::unique_ptr<Ring> bigger(new Ring((old->mask + 1) * 2));
+		for (std::ptrdiff_t i = t; i < b; ++i)
+			bigger->put(i, old->get(i));
+
+		retired.emplace_back(old);
+		ring.store(bigger.get(), std::memory_order_release);
+		return bigger.release();
+	}
+
+	alignas(cache_line) std::atomic<std::ptrdiff_t> top{ 0 };
+	alignas(cache_line) std::atomic<std::ptrdiff_t> bottom{ 0 };
+	std::atomic<Ring*> ring;
+	std::vector<std::unique_ptr<Ring>> retired;
+};
+
+
+#endif // !_Work_Stealing_Deque
@@ -0,0 +1,158 @@
+// Blocking_queue: pop_for gives up after its timeout and still takes an element pushed while it waits, pop_wait
+// with several producers and parked consumers delivers every element once, and in C++20 co_await q.pop()
+// resumes suspended coroutines in order on the pushing thread
+#include "../Queue/Blocking_queue.h"
+#include "Test.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+// try_pop and pop_for only move into an existing element, so they work without a default constructor
+struct No_default {
+	int v;
+	explicit No_default(int v) : v(v) {}
+};
+
+#ifdef BLOCKING_QUEUE_COROUTINES
+// Starts running at once and never suspends at the end, enough to drive an awaiter from main
+struct Detached {
+	struct promise_type {
+		Detached get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+Detached consume(Blocking_queue<int>& q, std::vector<int>& got, int n, std::thread::id& resumed_on) {
+	for (int i = 0; i < n; ++i) {
+		got.push_back(co_await q.pop());
+		resumed_on = std::this_thread::get_id();
+	}
+}
+#endif
+
+int main() {
+	using namespace std::chrono_literals;
+
+	{
+		Blocking_queue<int> q(8);
+		int out = -1;
+
+		auto start = std::chrono::steady_clock::now();
+		CHECK(!q.pop_for(out, 20ms));
+		CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+		CHECK(out == -1);
+
+		q.push(1);
+		CHECK(q.pop_for(out, 0ms) && out == 1);
+
+		// Pushed while pop_for is parked
+		std::thread late([&] {
+			std::this_thread::sleep_for(10ms);
+			q.push(2);
+		});
+		CHECK(q.pop_for(out, 10s) && out == 2);
+		late.join();
+		CHECK(q.empty());
+	}
+
+	{
+		Blocking_queue<No_default> q(4);
+		No_default out(0);
+		CHECK(!q.pop_for(out, 1ms));
+		q.emplace(5);
+		CHECK(q.pop_for(out, 1ms) && out.v == 5);
+	}
+
+	{
+		constexpr int producers = 4;
+		constexpr int consumers = 3;
+		constexpr int per_producer = 20'000;
+		constexpr int n = producers * per_producer;
+
+		Blocking_queue<int> q(64);
+		std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[n]);
+		for (int i = 0; i < n; ++i)
+			seen[i].store(0, std::memory_order_relaxed);
+
+		// Consumers start on an empty queue and park; -1 tells one of them to stop
+		std::vector<std::thread> threads;
+		for (int c = 0; c < consumers; ++c)
+			threads.emplace_back([&] {
+				for (int v; (v = q.pop_wait()) != -1;)
+					seen[v].fetch_add(1, std::memory_order_relaxed);
+			});
+		std::this_thread::sleep_for(20ms);
+
+		std::vector<std::thread> pushers;
+		for (int p = 0; p < producers; ++p)
+			pushers.emplace_back([&, p] {
+				for (int i = 0; i < per_producer; ++i)
+					q.push(p * per_producer + i);
+			});
+		for (auto& t : pushers)
+			t.join();
+
+		for (int c = 0; c < consumers; ++c)
+			q.push(-1);
+		for (auto& t : threads)
+			t.join();
+
+		int once = 0;
+		for (int i = 0; i < n; ++i)
+			once += seen[i].load(std::memory_order_relaxed) == 1;
+		CHECK(once == n);
+		CHECK(q.empty());
+	}
+
+#ifdef BLOCKING_QUEUE_COROUTINES
+	{
+		Blocking_queue<int> q(16);
+		std::vector<int> first, second;
+		std::thread::id first_on, second_on;
+
+		// Both suspend on the empty queue; each push resumes the oldest waiter right here
+		consume(q, first, 2, first_on);
+		consume(q, second, 2, second_on);
+		CHECK(first.empty() && second.empty());
+
+		q.push(10);
+		CHECK(first == std::vector<int>{ 10 } && second.empty());
+		q.push(11);
+		CHECK(second == std::vector<int>{ 11 });
+		q.push(12);
+		q.push(13);
+		CHECK((first == std::vector<int>{ 10, 12 }));
+		CHECK((second == std::vector<int>{ 11, 13 }));
+
+		// Elements already queued are taken without suspending
+		std::vector<int> ready;
+		std::thread::id ready_on;
+		q.push(20);
+		q.push(21);
+		consume(q, ready, 2, ready_on);
+		CHECK((ready == std::vector<int>{ 20, 21 }));
+
+		// Fed from another thread, the coroutine resumes on that thread
+		std::vector<int> remote;
+		std::thread::id remote_on;
+		consume(q, remote, 1, remote_on);
+		std::thread pusher([&] { q.push(30); });
+		std::thread::id pusher_id = pusher.get_id();
+		pusher.join();
+		CHECK(remote == std::vector<int>{ 30 });
+		CHECK(remote_on == pusher_id);
+		CHECK(first_on == std::this_thread::get_id());
+		CHECK(q.empty());
+	}
+#endif
+
+	return Test::result();
+}
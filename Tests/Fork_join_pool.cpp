@@ -0,0 +1,108 @@
+// Fork_join_pool: fork_join rethrows the first exception only once both branches have finished, nested forks
+// compute the right result, and run() from outside the pool hands back values and exceptions
+#include "../Thread_pool/Fork_join_pool.h"
+#include "Test.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+
+long long fib(Fork_join_pool& pool, int n) {
+	if (n < 12)
+		return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+	long long a = 0, b = 0;
+	pool.fork_join([&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+	return a + b;
+}
+
+// Keeps a branch busy long enough for another worker to steal its sibling
+void linger() {
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+}
+
+int main() {
+	Fork_join_pool pool(4);
+
+	// run() from outside the pool
+	CHECK(pool.run([] { return 42; }) == 42);
+	CHECK(*pool.run([] { return std::make_unique<std::string>("moved out"); }) == "moved out");
+
+	int side = 0;
+	pool.run([&] { side = 7; });
+	CHECK(side == 7);
+
+	std::string message;
+	try {
+		pool.run([]() -> int { throw std::runtime_error("from run"); });
+	}
+	catch (const std::runtime_error& e) {
+		message = e.what();
+	}
+	CHECK(message == "from run");
+
+	CHECK(pool.run([&] { return fib(pool, 25); }) == 75025);
+
+	// fork_join called from outside goes through run()
+	int left = 0, right = 0;
+	pool.fork_join([&] { left = 1; }, [&] { right = 2; });
+	CHECK(left == 1 && right == 2);
+
+	for (int round = 0; round < 20; ++round) {
+		// Only a throws: b must have finished by the time the exception arrives
+		std::atomic<bool> b_done{ false };
+		message.clear();
+		try {
+			pool.run([&] {
+				pool.fork_join(
+					[&] { linger(); throw std::runtime_error("a"); },
+					[&] { linger(); b_done.store(true); });
+			});
+		}
+		catch (const std::runtime_error& e) {
+			message = e.what();
+			CHECK(b_done.load());
+		}
+		CHECK(message == "a");
+
+		// Only b throws: a finished, and b's exception comes through
+		std::atomic<bool> a_done{ false };
+		message.clear();
+		try {
+			pool.run([&] {
+				pool.fork_join(
+					[&] { linger(); a_done.store(true); },
+					[&] { throw std::runtime_error("b"); });
+			});
+		}
+		catch (const std::runtime_error& e) {
+			message = e.what();
+			CHECK(a_done.load());
+		}
+		CHECK(message == "b");
+
+		// Both throw: a's exception is the one rethrown, after b has finished
+		b_done.store(false);
+		message.clear();
+		try {
+			pool.run([&] {
+				pool.fork_join(
+					[&] { throw std::runtime_error("a"); },
+					[&] { linger(); b_done.store(true); throw std::runtime_error("b"); });
+			});
+		}
+		catch (const std::runtime_error& e) {
+			message = e.what();
+			CHECK(b_done.load());
+		}
+		CHECK(message == "a");
+	}
+
+	// The pool still works after all that
+	CHECK(pool.run([&] { return fib(pool, 20); }) == 6765);
+
+	return Test::result();
+}
@@ -0,0 +1,139 @@
+// Forward_list::dedup keeps the first element of every key in list order: on sorted input that is std::unique's
+// result, and on shuffled input std::unique over the std::stable_sort of the input gives the same elements.
+// Covers empty, single-element, all-equal and all-distinct lists, extreme keys, a hash that puts everything in one
+// probe run, and the table going back to the list's allocator
+#include "../Allocators/Counting_allocator.h"
+#include "../Forward_list/Forward_list.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+struct Record {
+	long long key;
+	size_t seq;	// original position, to tell which of the equal elements stayed
+
+	bool operator==(const Record& other) const { return key == other.key && seq == other.seq; }
+};
+
+struct Key_hash {
+	size_t operator()(const Record& r) const noexcept { return std::hash<long long>()(r.key); }
+};
+
+struct Same_key {
+	bool operator()(const Record& a, const Record& b) const noexcept { return a.key == b.key; }
+};
+
+// Every key hashes alike: dedup must still tell them apart by KeyEqual
+struct One_bucket {
+	size_t operator()(const Record&) const noexcept { return 42; }
+};
+
+bool by_key(const Record& a, const Record& b) { return a.key < b.key; }
+
+template <typename Hash = Key_hash>
+void check_dedup(std::vector<Record> input, Hash hash = Hash()) {
+	Forward_list<Record> list(input.begin(), input.end());
+	size_t removed = list.dedup(hash, Same_key());
+
+	// std::unique after a stable sort keeps the first element of each key, as dedup does
+	std::vector<Record> expected = input;
+	std::stable_sort(expected.begin(), expected.end(), by_key);
+	expected.erase(std::unique(expected.begin(), expected.end(), Same_key()), expected.end());
+
+	std::vector<Record> got(list.begin(), list.end());
+	bool ok = removed == input.size() - expected.size() && list.size() == expected.size();
+
+	// dedup keeps list order, so got is ordered by seq; sorting it by key must give expected
+	ok = ok && std::is_sorted(got.begin(), got.end(), [](const Record& a, const Record& b) { return a.seq < b.seq; });
+	std::stable_sort(got.begin(), got.end(), by_key);
+	ok = ok && got == expected;
+
+	list.push_back({ 0, size_t(-1) });
+	ok = ok && list.back().seq == size_t(-1);
+	CHECK(ok);
+}
+
+std::vector<Record> random_records(std::mt19937_64& rng, size_t n, unsigned long long distinct) {
+	std::vector<Record> v(n);
+	for (size_t i = 0; i < n; ++i)
+		v[i] = { static_cast<long long>(rng() % distinct) - static_cast<long long>(distinct / 2), i };
+	return v;
+}
+
+int main() {
+	std::mt19937_64 rng(31);
+	using limits = std::numeric_limits<long long>;
+
+	check_dedup({});
+	check_dedup({ { 5, 0 } });
+	check_dedup({ { 5, 0 }, { 5, 1 } });
+	check_dedup({ { 5, 0 }, { 6, 1 } });
+
+	// Shuffled input, from nearly all duplicates to nearly all distinct
+	for (unsigned long long distinct : { 1ull, 2ull, 10ull, 1000ull, 1000000000ull }) {
+		check_dedup(random_records(rng, 5000, distinct));
+		check_dedup(random_records(rng, 37, distinct));
+	}
+
+	// Sorted input: std::unique alone is the expected result
+	{
+		std::vector<Record> sorted = random_records(rng, 3000, 200);
+		std::stable_sort(sorted.begin(), sorted.end(), by_key);
+		for (size_t i = 0; i < sorted.size(); ++i)
+			sorted[i].seq = i;
+		Forward_list<Record> list(sorted.begin(), sorted.end());
+		list.dedup(Key_hash(), Same_key());
+		sorted.erase(std::unique(sorted.begin(), sorted.end(), Same_key()), sorted.end());
+		CHECK(std::equal(list.begin(), list.end(), sorted.begin(), sorted.end()));
+		check_dedup(sorted);
+	}
+
+	// Extreme keys, repeated
+	{
+		const long long edges[] = { limits::min(), limits::min() + 1, -1, 0, 1, limits::max() - 1, limits::max() };
+		std::vector<Record> v(2000);
+		for (size_t i = 0; i < v.size(); ++i)
+			v[i] = { edges[rng() % std::size(edges)], i };
+		check_dedup(v);
+	}
+
+	// One probe run for everything
+	check_dedup(random_records(rng, 500, 100), One_bucket());
+	check_dedup(random_records(rng, 500, 1000000), One_bucket());
+
+	// The default hash and equality on plain values
+	{
+		std::vector<int> values(4000);
+		for (int& v : values)
+			v = static_cast<int>(rng() % 300);
+		Forward_list<int> list(values.begin(), values.end());
+		list.dedup();
+		std::vector<int> expected;
+		for (int v : values)
+			if (std::find(expected.begin(), expected.end(), v) == expected.end())
+				expected.push_back(v);
+		CHECK(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+	}
+
+	// The seen table comes from the list's allocator and is returned to it
+	{
+		Counting_allocator<int> alloc;
+		Forward_list<int, Counting_allocator<int>> list(alloc);
+		for (int i = 0; i < 1000; ++i)
+			list.push_back(i % 10);
+		std::uint64_t allocations = alloc.counters().allocations;
+		CHECK(list.dedup() == 990);
+		CHECK(alloc.counters().allocations == allocations + 1);
+		CHECK(alloc.counters().live_nodes == 10);
+	}
+
+	return Test::result();
+}
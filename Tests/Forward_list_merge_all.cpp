@@ -0,0 +1,140 @@
+// Forward_list::merge_all gives std::stable_sort's order of the lists laid end to end (this list first, then the
+// lists in range order), for random inputs with many equal keys, empty lists, a single non-empty run and the list
+// itself among the inputs; the sources end up empty and the tail is the last node. If comp throws, no node is lost
+#include "../Forward_list/Forward_list.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+struct Record {
+	int key;
+	size_t seq;	// position in the concatenation, to tell equal keys apart
+
+	bool operator==(const Record& other) const { return key == other.key && seq == other.seq; }
+};
+
+struct By_key {
+	bool operator()(const Record& a, const Record& b) const { return a.key < b.key; }
+};
+
+std::vector<Record> sorted_records(std::mt19937& rng, size_t n, int distinct, size_t& seq) {
+	std::vector<Record> v(n);
+	for (Record& r : v)
+		r = { static_cast<int>(rng() % static_cast<unsigned>(distinct)) - distinct / 2, seq++ };
+	std::stable_sort(v.begin(), v.end(), By_key());
+	return v;
+}
+
+// Elements in order, and push_back goes after the last node: appends a marker to both list and expected
+bool same(Forward_list<Record>& list, std::vector<Record> expected) {
+	bool ok = list.size() == expected.size();
+	list.push_back({ 0, size_t(-1) });
+	expected.push_back({ 0, size_t(-1) });
+	return ok && list.back().seq == size_t(-1) && std::equal(list.begin(), list.end(), expected.begin(), expected.end());
+}
+
+// One merge_all of this list and `sizes.size()` others, each sorted_records of the given size
+void check_merge(std::mt19937& rng, size_t own, const std::vector<size_t>& sizes, int distinct) {
+	size_t seq = 0;
+	std::vector<Record> all = sorted_records(rng, own, distinct, seq);
+	Forward_list<Record> list(all.begin(), all.end());
+
+	std::vector<Forward_list<Record>> lists;
+	for (size_t n : sizes) {
+		std::vector<Record> part = sorted_records(rng, n, distinct, seq);
+		lists.emplace_back(part.begin(), part.end());
+		all.insert(all.end(), part.begin(), part.end());
+	}
+	std::stable_sort(all.begin(), all.end(), By_key());
+
+	list.merge_all(lists, By_key());
+	CHECK(same(list, all));
+	CHECK(std::all_of(lists.begin(), lists.end(), [](const Forward_list<Record>& l) { return l.empty(); }));
+	for (Forward_list<Record>& l : lists) {
+		l.push_back({ 1, 1 });	// a drained source still has a usable tail
+		CHECK(l.size() == 1 && l.back().seq == 1);
+	}
+}
+
+int main() {
+	std::mt19937 rng(11);
+
+	// Empty everything, and nothing to merge
+	check_merge(rng, 0, {}, 10);
+	check_merge(rng, 0, { 0, 0, 0 }, 10);
+	check_merge(rng, 5, {}, 10);
+	check_merge(rng, 5, { 0, 0 }, 10);
+
+	// A single non-empty run, in this list or in one of the others
+	check_merge(rng, 0, { 0, 7, 0 }, 10);
+	check_merge(rng, 1, { 0, 0 }, 10);
+	check_merge(rng, 0, { 1 }, 10);
+
+	// Two to many runs, with equal keys across them and very uneven lengths
+	for (int round = 0; round < 200; ++round) {
+		size_t k = rng() % 17;
+		std::vector<size_t> sizes(k);
+		for (size_t& n : sizes)
+			n = rng() % 4 == 0 ? 0 : rng() % (round % 3 == 0 ? 2000 : 40);
+		check_merge(rng, rng() % 3 == 0 ? 0 : rng() % 100, sizes, round % 2 ? 5 : 1000);
+	}
+
+	// The list itself in the range is skipped
+	{
+		size_t seq = 0;
+		std::vector<Record> a = sorted_records(rng, 50, 8, seq), b = sorted_records(rng, 50, 8, seq);
+		std::vector<Forward_list<Record>> lists;
+		lists.emplace_back(a.begin(), a.end());
+		lists.emplace_back(b.begin(), b.end());
+		lists[0].merge_all(lists, By_key());
+
+		std::vector<Record> all = a;
+		all.insert(all.end(), b.begin(), b.end());
+		std::stable_sort(all.begin(), all.end(), By_key());
+		CHECK(same(lists[0], all));
+		CHECK(lists[1].empty());
+	}
+
+	// A comparison that throws part way leaves every node in this list
+	{
+		size_t seq = 0;
+		std::vector<Record> all = sorted_records(rng, 100, 20, seq);
+		Forward_list<Record> list(all.begin(), all.end());
+		std::vector<Forward_list<Record>> lists;
+		for (int i = 0; i < 5; ++i) {
+			std::vector<Record> part = sorted_records(rng, 100, 20, seq);
+			lists.emplace_back(part.begin(), part.end());
+			all.insert(all.end(), part.begin(), part.end());
+		}
+
+		int budget = 150;
+		bool threw = false;
+		try {
+			list.merge_all(lists, [&](const Record& a, const Record& b) {
+				if (--budget == 0)
+					throw std::runtime_error("comp");
+				return a.key < b.key;
+			});
+		}
+		catch (const std::runtime_error&) {
+			threw = true;
+		}
+		CHECK(threw);
+
+		std::vector<Record> got(list.begin(), list.end());
+		auto by_seq = [](const Record& a, const Record& b) { return a.seq < b.seq; };
+		std::sort(got.begin(), got.end(), by_seq);
+		std::sort(all.begin(), all.end(), by_seq);
+		CHECK(got == all);
+		CHECK(list.size() == all.size());
+		list.push_back({ 0, size_t(-1) });
+		CHECK(list.back().seq == size_t(-1));
+	}
+
+	return Test::result();
+}
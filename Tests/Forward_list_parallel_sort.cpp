@@ -0,0 +1,107 @@
+// Forward_list::parallel_sort: stable on equal keys, on the parallel path and on the fallback to sort for short
+// lists, empty and single-element lists, and a tail that still points at the last node afterwards
+#include "../Forward_list/Forward_list.h"
+#include "../Thread_pool/Thread_pool.h"
+#include "Test.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+struct Record {
+	unsigned key;
+	size_t seq;
+};
+
+struct By_key {
+	bool operator()(const Record& a, const Record& b) const { return a.key < b.key; }
+};
+
+Forward_list<Record> make_list(size_t n, unsigned distinct) {
+	std::mt19937 rng(7);
+	std::vector<Record> v(n);
+	for (size_t i = 0; i < n; ++i)
+		v[i] = { static_cast<unsigned>(rng() % distinct), i };
+	return Forward_list<Record>(v.begin(), v.end());
+}
+
+// Sorted by key, equal keys in their original order, nothing lost, and back() and push_back use the last node
+void check_sorted(Forward_list<Record>& list, size_t n) {
+	size_t count = 0;
+	bool ordered = true;
+	const Record* prev = nullptr;
+	for (const Record& r : list) {
+		if (prev && (r.key < prev->key || (r.key == prev->key && r.seq < prev->seq)))
+			ordered = false;
+		prev = &r;
+		++count;
+	}
+	CHECK(ordered);
+	CHECK(count == n);
+	CHECK(list.size() == n);
+	if (prev)
+		CHECK(&list.back() == prev);
+
+	list.push_back({ 0, n });
+	size_t last_seq = 0;
+	for (const Record& r : list)
+		last_seq = r.seq;
+	CHECK(last_seq == n);
+	CHECK(list.back().seq == n);
+	CHECK(list.size() == n + 1);
+}
+
+int main() {
+	Thread_pool pool(4);
+
+	// Enough nodes for 4 runs of at least parallel_sort_grain, with uneven lengths, and for 3 runs
+	for (size_t n : { 4 * Forward_list<Record>::parallel_sort_grain + 3, 3 * Forward_list<Record>::parallel_sort_grain }) {
+		for (unsigned distinct : { 1u, 7u, 1000u }) {
+			Forward_list<Record> list = make_list(n, distinct);
+			list.parallel_sort(pool, By_key());
+			check_sorted(list, n);
+		}
+	}
+
+	// Below the grain parallel_sort falls back to sort
+	{
+		Forward_list<Record> list = make_list(1000, 10);
+		list.parallel_sort(pool, By_key());
+		check_sorted(list, 1000);
+	}
+
+	{
+		Forward_list<Record> list;
+		list.parallel_sort(pool, By_key());
+		CHECK(list.empty());
+		CHECK(list.begin() == list.end());
+		list.push_back({ 1, 0 });
+		CHECK(list.size() == 1);
+		CHECK(list.front().key == 1);
+		CHECK(&list.front() == &list.back());
+	}
+
+	{
+		Forward_list<Record> list = make_list(1, 10);
+		list.parallel_sort(pool, By_key());
+		check_sorted(list, 1);
+	}
+
+	// With default comparison on plain values
+	{
+		Forward_list<int> list;
+		for (int i = 0; i < 100000; ++i)
+			list.push_back((i * 7919) % 100000);
+		list.parallel_sort(pool);
+		int expected = 0;
+		bool ordered = true;
+		for (int x : list)
+			ordered = ordered && x == expected++;
+		CHECK(ordered);
+		CHECK(expected == 100000);
+		CHECK(list.back() == 99999);
+	}
+
+	return Test::result();
+}
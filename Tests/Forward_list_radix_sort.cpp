@@ -0,0 +1,109 @@
+// Forward_list::radix_sort gives std::stable_sort's order for signed and unsigned keys of every width, including
+// the extreme values and negatives, with few and many distinct keys, all keys equal, empty and single-element
+// lists, and lists long enough for the interleaved passes; the tail is the last node afterwards
+#include "../Forward_list/Forward_list.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+template <typename Key>
+struct Record {
+	Key key;
+	size_t seq;	// original position, to check equal keys keep their order
+
+	bool operator==(const Record& other) const { return key == other.key && seq == other.seq; }
+};
+
+struct Key_of {
+	template <typename Key>
+	Key operator()(const Record<Key>& r) const noexcept { return r.key; }
+};
+
+// A key drawn from a handful of values around the extremes and zero, or uniformly over the whole range
+template <typename Key>
+Key random_key(std::mt19937_64& rng, int mode) {
+	using limits = std::numeric_limits<Key>;
+	const Key edges[] = { limits::min(), static_cast<Key>(limits::min() + 1), static_cast<Key>(-1), Key(0), Key(1),
+						  static_cast<Key>(limits::max() - 1), limits::max() };
+	switch (mode) {
+	case 0:		return edges[rng() % std::size(edges)];
+	case 1:		return static_cast<Key>(rng() % 7);	// few keys, every pass but the first skipped
+	case 2:		return static_cast<Key>(rng() % 60000);	// below 65536: two passes
+	default:	return static_cast<Key>(rng());
+	}
+}
+
+template <typename Key>
+void check_sort(std::mt19937_64& rng, size_t n, int mode) {
+	std::vector<Record<Key>> model(n);
+	for (size_t i = 0; i < n; ++i)
+		model[i] = { random_key<Key>(rng, mode), i };
+	Forward_list<Record<Key>> list(model.begin(), model.end());
+
+	list.radix_sort(Key_of());
+	std::stable_sort(model.begin(), model.end(), [](const Record<Key>& a, const Record<Key>& b) { return a.key < b.key; });
+
+	bool ok = list.size() == n && std::equal(list.begin(), list.end(), model.begin(), model.end());
+	list.push_back({ Key(0), size_t(-1) });
+	ok = ok && list.back().seq == size_t(-1);
+	CHECK(ok);
+}
+
+template <typename Key>
+void check_key_type(std::mt19937_64& rng) {
+	check_sort<Key>(rng, 0, 3);
+	check_sort<Key>(rng, 1, 3);
+	check_sort<Key>(rng, 2, 0);
+	for (int mode = 0; mode < 4; ++mode) {
+		check_sort<Key>(rng, 100, mode);
+		check_sort<Key>(rng, 5000, mode);
+	}
+
+	// All keys equal, at an extreme: the order must not change at all
+	std::vector<Record<Key>> same(3000);
+	for (size_t i = 0; i < same.size(); ++i)
+		same[i] = { std::numeric_limits<Key>::min(), i };
+	Forward_list<Record<Key>> list(same.begin(), same.end());
+	list.radix_sort(Key_of());
+	CHECK(std::equal(list.begin(), list.end(), same.begin(), same.end()));
+}
+
+int main() {
+	std::mt19937_64 rng(23);
+
+	check_key_type<std::int8_t>(rng);
+	check_key_type<std::uint8_t>(rng);
+	check_key_type<std::int16_t>(rng);
+	check_key_type<std::uint16_t>(rng);
+	check_key_type<std::int32_t>(rng);
+	check_key_type<std::uint32_t>(rng);
+	check_key_type<std::int64_t>(rng);
+	check_key_type<std::uint64_t>(rng);
+	check_key_type<char>(rng);
+
+	// Long enough that every interleaved walk has chains of its own
+	check_sort<std::int64_t>(rng, 200000, 3);
+	check_sort<std::int32_t>(rng, 200000, 0);
+
+	// The default key is the element itself
+	{
+		std::vector<long long> values(10000);
+		for (long long& v : values)
+			v = static_cast<long long>(rng());
+		values[0] = std::numeric_limits<long long>::min();
+		values[1] = std::numeric_limits<long long>::max();
+		Forward_list<long long> list(values.begin(), values.end());
+		list.radix_sort();
+		std::sort(values.begin(), values.end());
+		CHECK(std::equal(list.begin(), list.end(), values.begin(), values.end()));
+	}
+
+	return Test::result();
+}
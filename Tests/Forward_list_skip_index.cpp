@@ -0,0 +1,163 @@
+// Forward_list's skip index: advance, lower_bound, upper_bound and split_into give the same answers through the
+// const and non-const overloads, with no index, a full one and one missing appended nodes; const lookups from
+// several threads at once on a list whose index was never built; the index draws from the list's allocator and
+// goes back to it, also after a swap or move hands it to another list
+#include "../Allocators/Counting_allocator.h"
+#include "../Forward_list/Forward_list.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+// The element at each position, and the bounds of a few keys, against a vector of the same elements
+void check_lookups(Forward_list<int>& list, const std::vector<int>& model) {
+	const Forward_list<int>& clist = list;
+	bool ok = true;
+	for (size_t n = 0; n <= model.size(); n += 7) {
+		const int* expected = n < model.size() ? &model[n] : nullptr;
+		Forward_list<int>::const_iterator c = clist.advance(n);
+		ok = ok && (expected ? c != clist.end() && *c == *expected : c == clist.end());
+	}
+	for (int key = -2; key < static_cast<int>(model.size()) * 2 + 2; key += 3) {
+		size_t lower = std::lower_bound(model.begin(), model.end(), key) - model.begin();
+		size_t upper = std::upper_bound(model.begin(), model.end(), key) - model.begin();
+		ok = ok && std::distance(clist.begin(), clist.lower_bound(key)) == static_cast<std::ptrdiff_t>(lower);
+		ok = ok && std::distance(clist.begin(), clist.upper_bound(key)) == static_cast<std::ptrdiff_t>(upper);
+	}
+	CHECK(ok);
+
+	// The non-const overloads build or extend the index, then agree
+	ok = true;
+	for (size_t n = 0; n < model.size(); n += 5)
+		ok = ok && *list.advance(n) == model[n];
+	for (int key = -2; key < static_cast<int>(model.size()) * 2 + 2; key += 3) {
+		size_t lower = std::lower_bound(model.begin(), model.end(), key) - model.begin();
+		ok = ok && std::distance(list.begin(), list.lower_bound(key)) == static_cast<std::ptrdiff_t>(lower);
+	}
+	CHECK(ok);
+}
+
+// Every part of a split begins where its share of the list does, const or not
+void check_split(Forward_list<int>& list, const std::vector<int>& model, size_t parts) {
+	const Forward_list<int>& clist = list;
+	size_t expected_parts = std::min(parts, model.size());
+	Forward_list<int>::Split a = clist.split_into(parts);
+	Forward_list<int>::Split b = list.split_into(parts);
+	CHECK(a.parts() == expected_parts);
+	CHECK(b.parts() == expected_parts);
+
+	// Summing part by part visits each element once, whichever way the parts were found
+	long total = 0;
+	for (int x : model)
+		total += x;
+	CHECK(clist.reduce(a, 0L, [](long s, int x) { return s + x; }) == total);
+	CHECK(clist.reduce(b, 0L, [](long s, int x) { return s + x; }) == total);
+}
+
+int main() {
+	std::vector<int> model;
+	Forward_list<int> list;
+	for (int i = 0; i < 1000; ++i) {
+		model.push_back(2 * i);
+		list.push_back(2 * i);
+	}
+
+	check_lookups(list, model);	// no index for the const calls, then built
+	check_split(list, model, 37);
+
+	for (int i = 1000; i < 1100; ++i) {	// appended nodes the index does not cover yet
+		model.push_back(2 * i);
+		list.push_back(2 * i);
+	}
+	check_lookups(list, model);
+	check_split(list, model, 64);
+
+	list.build_index(8);
+	check_lookups(list, model);
+
+	list.pop_front();	// drops the index
+	model.erase(model.begin());
+	check_lookups(list, model);
+	check_split(list, model, 5000);
+
+	list.release_index();
+	check_split(list, model, 3);
+
+	// Readers only: nothing may be built underneath them
+	{
+		Forward_list<int> shared;
+		for (int i = 0; i < 20000; ++i)
+			shared.push_back(i);
+		const Forward_list<int>& reader = shared;
+
+		std::vector<std::thread> threads;
+		std::vector<int> ok(4, 1);
+		for (size_t t = 0; t < 4; ++t) {
+			threads.emplace_back([&reader, &ok, t] {
+				for (int q = 0; q < 50; ++q) {
+					int key = static_cast<int>((t * 7919 + static_cast<size_t>(q) * 104729) % 20000);
+					ok[t] &= *reader.lower_bound(key) == key;
+					ok[t] &= *reader.advance(static_cast<size_t>(key)) == key;
+					ok[t] &= reader.split_into(16).parts() == 16;
+				}
+			});
+		}
+		for (std::thread& th : threads)
+			th.join();
+		CHECK(std::count(ok.begin(), ok.end(), 1) == 4);
+	}
+
+	// Everything the index holds is counted by the list's allocator and returned to it
+	{
+		using Counted_list = Forward_list<int, Counting_allocator<int>>;
+		Counting_allocator<int> alloc;
+		const Allocation_counters& counts = alloc.counters();
+
+		{
+			Counted_list a(alloc);
+			for (int i = 0; i < 1000; ++i)
+				a.push_back(i);
+			std::uint64_t nodes_only = counts.live_bytes;
+
+			a.build_index(4);
+			CHECK(counts.live_bytes > nodes_only);
+			CHECK(*a.advance(777) == 777);
+
+			a.release_index();
+			CHECK(counts.live_bytes == nodes_only);
+
+			// The index travels with the nodes and is freed by whichever list ends up holding it
+			CHECK(*a.lower_bound(500) == 500);
+			Counted_list b(alloc);
+			b.push_back(-1);
+			b.swap(a);
+			CHECK(*b.advance(999) == 999);
+			Counted_list c(std::move(b));
+			CHECK(*c.advance(10) == 10);
+		}
+		CHECK(counts.live_bytes == 0);
+		CHECK(counts.allocations == counts.deallocations);
+	}
+
+	// polymorphic_allocator cannot be assigned: moving and swapping lists with an index must not need that
+	{
+		std::pmr::unsynchronized_pool_resource pool;
+		pmr::Forward_list<int> a(&pool), b(&pool);
+		for (int i = 0; i < 100; ++i)
+			a.push_back(i);
+		a.build_index(3);
+		a.swap(b);
+		pmr::Forward_list<int> c(std::move(b));
+		CHECK(*c.advance(50) == 50);
+		a = std::move(c);
+		CHECK(*a.lower_bound(99) == 99);
+	}
+
+	return Test::result();
+}
@@ -0,0 +1,37 @@
+// Forward_list operation counters: remove_if counts each removed node once, as an erase, whether it was at the
+// head or further along. Without CONTAINER_STATS only the results are checked
+#include "../Forward_list/Forward_list.h"
+#include "Test.h"
+
+
+int main() {
+	for (int head_run : { 0, 3, 10 }) {
+		Forward_list<int> list;
+		for (int i = 0; i < 10; ++i)
+			list.push_back(i < head_run ? -1 : i);
+
+		Container_stats before = list.stats();
+		size_t removed = list.remove_if([](int x) { return x < 0 || x % 3 == 0; });
+		Container_stats after = list.stats();
+
+		size_t expected = 0;
+		for (int i = 0; i < 10; ++i)
+			expected += i < head_run || i % 3 == 0;
+		CHECK(removed == expected);
+		CHECK(list.size() == 10 - expected);
+#ifdef CONTAINER_STATS
+		CHECK(after.erases - before.erases == expected);
+		CHECK(after.pops == before.pops);
+#else
+		(void)before;
+		(void)after;
+#endif
+
+		// The tail is right whether the list was emptied or not
+		list.push_back(100);
+		CHECK(list.back() == 100);
+		CHECK(list.size() == 11 - expected);
+	}
+
+	return Test::result();
+}
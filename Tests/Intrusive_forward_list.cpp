@@ -0,0 +1,180 @@
+// Intrusive_forward_list keeps size and back() right through splice_after of a range running to end(), merge when
+// the other list's last element sorts first, moves and swaps involving an empty list, and erase_after of the last
+// element; Member_hook finds the object from its hook for a type with no default constructor
+#include "../Forward_list/Intrusive_forward_list.h"
+#include "Test.h"
+
+#include <iterator>
+#include <vector>
+
+
+struct Second;
+
+struct Item : Intrusive_hook<> {
+	int key;
+	int id;
+	Intrusive_hook<Second> second;	// the same Item on a second list, through Member_hook
+
+	Item(int key, int id) : key(key), id(id) {}
+};
+
+using List = Intrusive_forward_list<Item>;
+using Second_list = Intrusive_forward_list<Item, Member_hook<Item, Intrusive_hook<Second>, &Item::second>>;
+
+struct By_key {
+	bool operator()(const Item& a, const Item& b) const { return a.key < b.key; }
+};
+
+// The ids in list order, and back() and size() agree with them
+template <typename L>
+std::vector<int> ids(const L& list) {
+	std::vector<int> out;
+	for (const Item& x : list)
+		out.push_back(x.id);
+	bool ok = out.size() == list.size() && (out.empty() || list.back().id == out.back());
+	CHECK(ok);
+	return out;
+}
+
+// A further push_back must land after the last element: catches a stale tail
+template <typename L>
+void check_tail(L& list, Item& extra) {
+	std::vector<int> before = ids(list);
+	list.push_back(extra);
+	before.push_back(extra.id);
+	CHECK(ids(list) == before);
+	CHECK(&list.back() == &extra);
+	list.erase(extra);
+}
+
+int main() {
+	std::vector<Item> items;
+	for (int i = 0; i < 20; ++i)
+		items.emplace_back(i % 5, i);
+	Item extra(100, 100);
+
+	{
+		// (first, end()) of a list moved to the middle of another: the source's tail becomes first
+		List a, b;
+		for (int i = 0; i < 5; ++i)
+			a.push_back(items[i]);
+		for (int i = 5; i < 10; ++i)
+			b.push_back(items[i]);
+
+		a.splice_after(a.begin(), b, std::next(b.begin()), b.end());
+		CHECK((ids(a) == std::vector<int>{ 0, 7, 8, 9, 1, 2, 3, 4 }));
+		CHECK((ids(b) == std::vector<int>{ 5, 6 }));
+		check_tail(a, extra);
+		check_tail(b, extra);
+
+		// The same at the end of the target, so the target's tail moves too
+		List::const_iterator last = a.begin();
+		while (std::next(last) != a.end())
+			++last;
+		a.splice_after(last, b, b.before_begin(), b.end());
+		CHECK((ids(a) == std::vector<int>{ 0, 7, 8, 9, 1, 2, 3, 4, 5, 6 }));
+		CHECK(b.empty());
+		check_tail(a, extra);
+		check_tail(b, extra);
+
+		// An empty range changes nothing
+		a.splice_after(a.before_begin(), b, b.before_begin(), b.end());
+		CHECK(a.size() == 10 && b.empty());
+		a.clear();
+	}
+
+	{
+		// other's last element sorts before this list's: the merged tail is still this list's last element
+		List a, b;
+		a.push_back(items[0]);	// key 0
+		a.push_back(items[4]);	// key 4
+		b.push_back(items[5]);	// key 0
+		b.push_back(items[7]);	// key 2
+
+		a.merge(b, By_key());
+		CHECK((ids(a) == std::vector<int>{ 0, 5, 7, 4 }));
+		CHECK(b.empty());
+		check_tail(a, extra);
+		check_tail(b, extra);
+
+		// Equal last keys: other's goes last
+		List c;
+		c.push_back(items[9]);	// key 4
+		a.merge(c, By_key());
+		CHECK((ids(a) == std::vector<int>{ 0, 5, 7, 4, 9 }));
+		check_tail(a, extra);
+
+		// Merging into an empty list
+		List d;
+		d.merge(a, By_key());
+		CHECK((ids(d) == std::vector<int>{ 0, 5, 7, 4, 9 }));
+		check_tail(d, extra);
+		d.clear();
+	}
+
+	{
+		// take(), through moves and swap, from an empty list leaves both lists empty and usable
+		List empty;
+		List moved(std::move(empty));
+		CHECK(moved.empty() && empty.empty());
+		check_tail(moved, extra);
+		check_tail(empty, extra);
+
+		List full;
+		full.push_back(items[0]);
+		full.push_back(items[1]);
+		full = std::move(empty);
+		CHECK(full.empty() && empty.empty());
+		check_tail(full, extra);
+
+		full.push_back(items[2]);
+		swap(full, empty);
+		CHECK(full.empty());
+		CHECK((ids(empty) == std::vector<int>{ 2 }));
+		check_tail(full, extra);
+		check_tail(empty, extra);
+		empty.clear();
+	}
+
+	{
+		// Erasing the last element, alone and as the end of a range
+		List a;
+		for (int i = 0; i < 4; ++i)
+			a.push_back(items[i]);
+
+		List::iterator before_last = std::next(a.begin(), 2);
+		CHECK(a.erase_after(before_last) == a.end());
+		CHECK((ids(a) == std::vector<int>{ 0, 1, 2 }));
+		check_tail(a, extra);
+
+		a.erase_after(a.begin(), a.end());
+		CHECK((ids(a) == std::vector<int>{ 0 }));
+		check_tail(a, extra);
+
+		a.erase_after(a.before_begin());
+		CHECK(a.empty());
+		check_tail(a, extra);
+	}
+
+	{
+		// Member_hook: the same objects on a second list, found back from their member hook
+		List first;
+		Second_list second;
+		for (int i = 0; i < 10; ++i) {
+			first.push_back(items[i]);
+			second.push_front(items[i]);
+		}
+		CHECK((ids(second) == std::vector<int>{ 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 }));
+		CHECK(&second.front() == &items[9]);
+		CHECK(&*second.iterator_to(items[3]) == &items[3]);
+
+		second.sort(By_key());
+		CHECK((ids(second) == std::vector<int>{ 5, 0, 6, 1, 7, 2, 8, 3, 9, 4 }));
+		CHECK(ids(first).size() == 10);
+		check_tail(second, extra);
+		first.clear();
+		second.clear();
+	}
+
+	return Test::result();
+}
@@ -0,0 +1,138 @@
+// MPMC_queue stays usable after T throws: a throwing construction leaves no cell that producers or consumers
+// wait on, and an element whose move into try_pop's out throws is dropped without blocking the ring
+#include "../Queue/MPMC_queue.h"
+#include "Test.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+struct Fragile {
+	static inline std::atomic<int> live{ 0 };
+	static inline bool throw_on_copy = false;
+	static inline bool throw_on_assign = false;
+	int v = 0;
+
+	// Negative values stand for a construction that fails
+	Fragile(int v) : v(v) {
+		if (v < 0)
+			throw std::runtime_error("construct");
+		++live;
+	}
+	Fragile(const Fragile& other) : v(other.v) {
+		if (throw_on_copy)
+			throw std::runtime_error("copy");
+		++live;
+	}
+	Fragile& operator=(Fragile&& other) {
+		if (throw_on_assign)
+			throw std::runtime_error("assign");
+		v = other.v;
+		return *this;
+	}
+	~Fragile() { --live; }
+};
+
+int main() {
+	{
+		MPMC_queue<Fragile> q(4);
+		Fragile item(0);
+
+		// More failed constructions than cells, so every cell is left empty at least once
+		for (int i = 0; i < 10; ++i) {
+			CHECK(q.try_push(Fragile(i)));
+			Fragile::throw_on_copy = true;
+			bool threw = false;
+			try {
+				q.push(item);
+			}
+			catch (const std::runtime_error&) {
+				threw = true;
+			}
+			Fragile::throw_on_copy = false;
+			CHECK(threw);
+
+			Fragile out(100);
+			CHECK(q.try_pop(out));
+			CHECK(out.v == i);
+			CHECK(!q.try_pop(out));
+		}
+
+		// The element whose assignment throws is dropped, the next one is still delivered
+		CHECK(q.try_push(Fragile(1)));
+		CHECK(q.try_push(Fragile(2)));
+		Fragile out(100);
+		Fragile::throw_on_assign = true;
+		bool threw = false;
+		try {
+			(void)q.try_pop(out);
+		}
+		catch (const std::runtime_error&) {
+			threw = true;
+		}
+		Fragile::throw_on_assign = false;
+		CHECK(threw);
+		CHECK(q.try_pop(out));
+		CHECK(out.v == 2);
+		CHECK(q.empty());
+
+		// Filling the ring still works on every cell
+		for (int i = 0; i < 4; ++i)
+			CHECK(q.try_push(Fragile(i)));
+		CHECK(!q.try_push(Fragile(4)));
+	}
+	CHECK(Fragile::live == 0);
+
+	// Producers whose constructions throw now and then, next to consumers
+	{
+		MPMC_queue<Fragile> q(8);
+		constexpr int per_producer = 20000;
+		constexpr int delivered = 2 * (per_producer - (per_producer + 6) / 7);
+		std::atomic<int> popped{ 0 };
+		std::atomic<long> sum{ 0 };
+		std::vector<std::thread> threads;
+		for (int p = 0; p < 2; ++p) {
+			threads.emplace_back([&q] {
+				for (int i = 0; i < per_producer; ++i) {
+					try {
+						q.emplace(i % 7 == 0 ? -1 : i);
+					}
+					catch (const std::runtime_error&) {}
+				}
+			});
+		}
+		for (int c = 0; c < 2; ++c) {
+			threads.emplace_back([&] {
+				Fragile out(0);
+				while (popped.load() < delivered) {
+					if (q.try_pop(out)) {
+						sum += out.v;
+						++popped;
+					}
+					else {
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+		for (std::thread& t : threads)
+			t.join();
+
+		long expected = 0;
+		for (int i = 0; i < per_producer; ++i)
+			if (i % 7 != 0)
+				expected += 2 * i;
+		CHECK(popped.load() == delivered);
+		CHECK(sum.load() == expected);
+
+		// Cells left empty at the end are only skipped by the next pop
+		Fragile out(0);
+		CHECK(!q.try_pop(out));
+		CHECK(q.empty());
+	}
+	CHECK(Fragile::live == 0);
+
+	return Test::result();
+}
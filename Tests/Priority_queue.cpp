@@ -0,0 +1,164 @@
+// Priority_queue pops in the same order as std::priority_queue for arities 2, 4 and 8, through push, push_range,
+// heapifying constructors and pop_n. Handle_priority_queue keeps every live handle naming its element through
+// decrease-key, increase-key, erase and pop, and reports removed handles as gone even once their slot is reused
+#include "../Priority_queue/Priority_queue.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <vector>
+
+
+template <size_t Arity, class Compare>
+void check_pop_order(unsigned seed) {
+	std::mt19937 rng(seed);
+	Priority_queue<int, std::vector<int>, Compare, Arity> q;
+	std::priority_queue<int, std::vector<int>, Compare> model;
+	bool ok = true;
+
+	for (int step = 0; step < 20000; ++step) {
+		unsigned op = rng() % 10;
+		if (op < 5) {
+			int v = static_cast<int>(rng() % 500) - 250;	// plenty of equal keys
+			q.push(v);
+			model.push(v);
+		}
+		else if (op < 9) {
+			if (!model.empty()) {
+				ok = ok && q.top() == model.top();
+				q.pop();
+				model.pop();
+			}
+		}
+		else {
+			std::vector<int> batch(rng() % 40);
+			for (int& v : batch)
+				v = static_cast<int>(rng() % 500) - 250;
+			q.push_range(batch.begin(), batch.end());
+			for (int v : batch)
+				model.push(v);
+		}
+		ok = ok && q.size() == model.size() && (model.empty() || q.top() == model.top());
+	}
+	CHECK(ok);
+
+	std::vector<int> drained, expected;
+	q.pop_n(std::back_inserter(drained), q.size());
+	for (; !model.empty(); model.pop())
+		expected.push_back(model.top());
+	CHECK(drained == expected);
+	CHECK(q.empty());
+
+	// Heapified from a container, then drained in order
+	std::vector<int> values(3001);
+	for (int& v : values)
+		v = static_cast<int>(rng() % 1000);
+	Priority_queue<int, std::vector<int>, Compare, Arity> built(Compare(), values);
+	std::vector<int> sorted = values;
+	std::sort(sorted.begin(), sorted.end(), [](int a, int b) { return Compare()(b, a); });
+	drained.clear();
+	built.pop_n(std::back_inserter(drained), sorted.size());
+	CHECK(drained == sorted);
+}
+
+template <size_t Arity>
+void check_handles(unsigned seed) {
+	using Queue = Handle_priority_queue<int, std::less<int>, Arity>;
+	using Handle = typename Queue::Handle;
+
+	struct Tracked {
+		Handle h;
+		int val;
+		bool live;
+	};
+
+	std::mt19937 rng(seed);
+	Queue q;
+	std::vector<Tracked> all;	// every handle ever returned
+	std::vector<size_t> live;	// indices into all of the elements still queued
+
+	auto random_value = [&] { return static_cast<int>(rng() % 2000) - 1000; };
+	auto remove_live = [&](size_t i) {
+		all[live[i]].live = false;
+		live[i] = live.back();
+		live.pop_back();
+	};
+
+	bool ok = true;
+	for (int step = 0; step < 20000; ++step) {
+		unsigned op = rng() % 10;
+		if (op < 4 || live.empty()) {
+			int v = random_value();
+			all.push_back({ q.push(v), v, true });
+			live.push_back(all.size() - 1);
+		}
+		else if (op < 6) {
+			// Decrease-key and increase-key, by a small or a large step
+			Tracked& t = all[live[rng() % live.size()]];
+			int delta = static_cast<int>(rng() % 2 ? rng() % 5 : rng() % 3000) * (rng() % 2 ? 1 : -1);
+			t.val += delta;
+			q.update(t.h, t.val);
+		}
+		else if (op < 8) {
+			size_t i = rng() % live.size();
+			q.erase(all[live[i]].h);
+			remove_live(i);
+		}
+		else {
+			int greatest = all[live[0]].val;
+			for (size_t i : live)
+				greatest = std::max(greatest, all[i].val);
+			ok = ok && q.top() == greatest;
+
+			Handle top = q.top_handle();
+			auto it = std::find_if(live.begin(), live.end(), [&](size_t i) { return all[i].h == top; });
+			ok = ok && it != live.end() && all[*it].val == greatest;
+			q.pop();
+			if (it != live.end())
+				remove_live(static_cast<size_t>(it - live.begin()));
+			ok = ok && !q.contains(top);
+		}
+
+		ok = ok && q.size() == live.size();
+		if (step % 64 == 0) {
+			for (const Tracked& t : all)
+				ok = ok && q.contains(t.h) == t.live && (!t.live || q[t.h] == t.val);
+		}
+	}
+	CHECK(ok);
+
+	// Drain: values come out greatest first and every handle ends up gone
+	std::vector<int> expected;
+	for (size_t i : live)
+		expected.push_back(all[i].val);
+	std::sort(expected.begin(), expected.end(), std::greater<int>());
+	std::vector<int> drained;
+	for (; !q.empty(); q.pop())
+		drained.push_back(q.top());
+	CHECK(drained == expected);
+	CHECK(std::none_of(all.begin(), all.end(), [&](const Tracked& t) { return q.contains(t.h); }));
+
+	// A slot freed by erase is reused by the next push; the old handle must not name the new element
+	Handle old = q.push(1);
+	q.erase(old);
+	Handle reused = q.push(2);
+	CHECK(!q.contains(old));
+	CHECK(q.contains(reused) && q[reused] == 2);
+	CHECK(old != reused);
+}
+
+int main() {
+	check_pop_order<2, std::less<int>>(1);
+	check_pop_order<4, std::less<int>>(2);
+	check_pop_order<8, std::less<int>>(3);
+	check_pop_order<4, std::greater<int>>(4);
+
+	check_handles<2>(5);
+	check_handles<4>(6);
+	check_handles<8>(7);
+
+	return Test::result();
+}
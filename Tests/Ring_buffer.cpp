@@ -0,0 +1,101 @@
+// Ring_buffer's consumer side stays consistent when Queue::pop (pop_front) and try_pop_front are mixed, and one
+// producer thread hands every element to one consumer thread in order
+#include "../Queue/Queue.h"
+#include "../Queue/Ring_buffer.h"
+#include "Test.h"
+
+#include <thread>
+
+
+// Queue keeps its container protected, as std::queue does; this reaches the ring's try_pop_front through it
+struct Ring_queue : Queue<int, Ring_buffer<int, 8>> {
+	bool try_pop(int& out) { return cont.try_pop_front(out); }
+	size_type ring_size() const { return cont.size(); }
+};
+
+int main() {
+	{
+		Ring_queue q;
+		int out = -1;
+		q.push(1);
+		CHECK(q.try_pop(out) && out == 1);
+		CHECK(!q.try_pop(out));
+
+		// pop moves head past the tail try_pop_front last saw, the empty check must not rely on it
+		q.push(2);
+		q.pop();
+		q.push(3);
+		q.pop();
+		CHECK(q.empty());
+		CHECK(!q.try_pop(out));
+		CHECK(q.ring_size() == 0);
+
+		q.push(4);
+		CHECK(q.try_pop(out) && out == 4);
+		CHECK(!q.try_pop(out));
+	}
+
+	{
+		// Alternate the two pops over several laps of the ring
+		Ring_queue q;
+		int next_in = 0, next_out = 0;
+		for (int round = 0; round < 1000; ++round) {
+			int n = round % 8 + 1;
+			for (int i = 0; i < n; ++i)
+				q.push(next_in++);
+			for (int i = 0; i < n; ++i) {
+				if ((round + i) % 3 == 0) {
+					CHECK(q.front() == next_out);
+					q.pop();
+				}
+				else {
+					int out = -1;
+					CHECK(q.try_pop(out) && out == next_out);
+				}
+				++next_out;
+			}
+			int out = -1;
+			CHECK(!q.try_pop(out));
+			CHECK(q.size() == 0);
+		}
+	}
+
+	{
+		// Two-thread SPSC hand-off through a small ring, so both sides keep hitting full and empty
+		constexpr long long n = 200'000;
+		auto* ring = new Ring_buffer<long long, 16>();
+
+		std::thread producer([&] {
+			for (long long i = 0; i < n; ++i)
+				while (!ring->try_push_back(i))
+					std::this_thread::yield();
+		});
+
+		long long expected = 0;
+		bool in_order = true;
+		while (expected < n) {
+			long long out;
+			if (ring->try_pop_front(out)) {
+				in_order = in_order && out == expected;
+				++expected;
+			}
+			else if (!ring->empty() && expected % 2 == 0) {
+				// Mix in pop_front on the consumer side too
+				in_order = in_order && ring->front() == expected;
+				ring->pop_front();
+				++expected;
+			}
+			else
+				std::this_thread::yield();
+		}
+		producer.join();
+
+		CHECK(in_order);
+		CHECK(ring->empty());
+		long long out;
+		CHECK(!ring->try_pop_front(out));
+		delete ring;
+	}
+
+	return Test::result();
+}
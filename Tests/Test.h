@@ -0,0 +1,30 @@
+#ifndef _Test
+#define _Test
+
+#include <cstdio>
+
+
+// Minimal checks for the ctest suite: each Tests/*.cpp is one executable, CHECK reports a failed condition
+// and the test fails if any check did
+namespace Test {
+
+	inline int failures = 0;
+
+	inline void check(bool ok, const char* expr, const char* file, int line) {
+		if (ok) return;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+		++failures;
+	}
+
+	// main returns this
+	inline int result() {
+		if (failures)
+			std::fprintf(stderr, "%d check(s) failed\n", failures);
+		return failures ? 1 : 0;
+	}
+}
+
+#define CHECK(expr) Test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+
+#endif // !_Test
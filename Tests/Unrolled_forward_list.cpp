@@ -0,0 +1,296 @@
+// Unrolled_forward_list: remove_if, unique, sort and merge leave a valid list that leaks no element or chunk
+// when the predicate or comparison throws partway; splice_after within one list; resize keeping the front
+#include "../Unrolled_forward_list/Unrolled_forward_list.h"
+#include "../Allocators/Counting_allocator.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+// Counts live objects, so elements that are neither in the list nor destroyed show up
+struct Counted {
+	static inline long live = 0;
+	int v;
+
+	Counted(int v) : v(v) { ++live; }
+	Counted(const Counted& other) : v(other.v) { ++live; }
+	Counted& operator=(const Counted&) = default;
+	~Counted() { --live; }
+
+	bool operator==(const Counted& other) const { return v == other.v; }
+};
+
+// Four elements per chunk, so a few dozen elements span many chunks
+using List = Unrolled_forward_list<Counted, Counting_allocator<Counted>, 4>;
+
+// Throws on the n-th call of the wrapped predicate or comparison
+struct Fuse {
+	int left;
+
+	void tick() {
+		if (--left == 0)
+			throw std::runtime_error("fuse");
+	}
+};
+
+List make_list(const std::vector<int>& values, const Counting_allocator<Counted>& alloc) {
+	List list(alloc);
+	for (auto it = values.rbegin(); it != values.rend(); ++it)
+		list.push_front(*it);
+	return list;
+}
+
+std::vector<int> contents(const List& list) {
+	std::vector<int> out;
+	for (const Counted& x : list)
+		out.push_back(x.v);
+	return out;
+}
+
+// size() agrees with a walk, and the only live elements and chunks are the list's
+void check_valid(const List& list, const Counting_allocator<Counted>& alloc) {
+	CHECK(list.size() == static_cast<size_t>(std::distance(list.begin(), list.end())));
+	CHECK(Counted::live == static_cast<long>(list.size()));
+	CHECK(alloc.counters().live_nodes <= list.size());	// no empty or spare chunk left over
+}
+
+template <typename F>
+bool throws(F f) {
+	try {
+		f();
+	}
+	catch (const std::runtime_error&) {
+		return true;
+	}
+	return false;
+}
+
+std::vector<int> iota(int n) {
+	std::vector<int> v(n);
+	for (int i = 0; i < n; ++i)
+		v[i] = i;
+	return v;
+}
+
+void test_remove_if_throwing() {
+	for (int at : { 1, 2, 5, 13, 40 }) {
+		Counting_allocator<Counted> alloc;
+		{
+			List list = make_list(iota(40), alloc);
+			Fuse fuse{ at };
+			CHECK(throws([&] { list.remove_if([&](const Counted& x) { fuse.tick(); return x.v % 2 == 0; }); }));
+
+			// The odd values already visited, then everything from the element whose predicate threw
+			std::vector<int> expected;
+			for (int i = 0; i < 40; ++i)
+				if (i >= at - 1 || i % 2 != 0)
+					expected.push_back(i);
+			CHECK(contents(list) == expected);
+			check_valid(list, alloc);
+
+			list.push_front(-1);
+			CHECK(list.front().v == -1);
+		}
+		CHECK(Counted::live == 0);
+		CHECK(alloc.counters().live_nodes == 0);
+	}
+}
+
+void test_unique_throwing() {
+	std::vector<int> values;
+	for (int i = 0; i < 40; ++i)
+		values.push_back(i / 3);
+
+	for (int at : { 1, 4, 20 }) {
+		Counting_allocator<Counted> alloc;
+		{
+			List list = make_list(values, alloc);
+			Fuse fuse{ at };
+			CHECK(throws([&] { list.unique([&](const Counted& a, const Counted& b) { fuse.tick(); return a == b; }); }));
+
+			// Element i + 1 is compared by call i, so the first `at` elements were reached
+			std::vector<int> expected;
+			for (int i = 0; i < 40; ++i)
+				if (i >= at || i == 0 || values[i] != values[i - 1])
+					expected.push_back(values[i]);
+			CHECK(contents(list) == expected);
+			check_valid(list, alloc);
+		}
+		CHECK(Counted::live == 0);
+		CHECK(alloc.counters().live_nodes == 0);
+	}
+}
+
+void test_sort_throwing() {
+	std::vector<int> values;
+	for (int i = 0; i < 50; ++i)
+		values.push_back((i * 37) % 50);
+
+	for (int at : { 1, 3, 10, 60, 150 }) {
+		Counting_allocator<Counted> alloc;
+		{
+			List list = make_list(values, alloc);
+			Fuse fuse{ at };
+			CHECK(throws([&] { list.sort([&](const Counted& a, const Counted& b) { fuse.tick(); return a.v < b.v; }); }));
+
+			std::vector<int> kept = contents(list);
+			std::sort(kept.begin(), kept.end());
+			CHECK(kept == iota(50));
+			check_valid(list, alloc);
+
+			list.sort([](const Counted& a, const Counted& b) { return a.v < b.v; });
+			CHECK(contents(list) == iota(50));
+		}
+		CHECK(Counted::live == 0);
+		CHECK(alloc.counters().live_nodes == 0);
+	}
+}
+
+void test_merge_throwing() {
+	std::vector<int> evens, odds;
+	for (int i = 0; i < 30; ++i)
+		(i % 2 ? odds : evens).push_back(i);
+
+	for (int at : { 1, 7, 25 }) {
+		Counting_allocator<Counted> alloc;
+		{
+			List list = make_list(evens, alloc);
+			List other = make_list(odds, alloc);
+			Fuse fuse{ at };
+			CHECK(throws([&] { list.merge(other, [&](const Counted& a, const Counted& b) { fuse.tick(); return a.v < b.v; }); }));
+
+			std::vector<int> kept = contents(list);
+			std::sort(kept.begin(), kept.end());
+			CHECK(kept == iota(30));
+			CHECK(other.empty());
+			CHECK(other.begin() == other.end());
+			check_valid(list, alloc);
+		}
+		CHECK(Counted::live == 0);
+		CHECK(alloc.counters().live_nodes == 0);
+	}
+}
+
+template <typename L>
+std::vector<int> values_of(const L& list) {
+	return std::vector<int>(list.begin(), list.end());
+}
+
+void test_splice_same_list() {
+	using Ints = Unrolled_forward_list<int>;
+	{
+		Ints list{ 1, 2, 3, 4 };
+		list.splice_after(std::next(list.cbegin(), 2), list, list.cbegin());
+		CHECK(values_of(list) == std::vector<int>({ 1, 3, 2, 4 }));
+		CHECK(list.size() == 4);
+	}
+	{
+		Ints list{ 1, 2, 3, 4, 5, 6 };
+		list.splice_after(std::next(list.cbegin(), 4), list, list.cbegin(), std::next(list.cbegin(), 3));
+		CHECK(values_of(list) == std::vector<int>({ 1, 4, 5, 2, 3, 6 }));
+		CHECK(list.size() == 6);
+	}
+	{
+		Ints list{ 1, 2, 3, 4, 5, 6 };
+		list.splice_after(list.cbegin(), list, std::next(list.cbegin(), 2), list.cend());
+		CHECK(values_of(list) == std::vector<int>({ 1, 4, 5, 6, 2, 3 }));
+	}
+
+	// Against a vector model, with small chunks so erasing merges chunks and inserting splits them
+	using Small = Unrolled_forward_list<int, std::allocator<int>, 4>;
+	std::mt19937 rng(3);
+	for (int round = 0; round < 2000; ++round) {
+		int n = 2 + static_cast<int>(rng() % 30);
+		std::vector<int> model = iota(n);
+		Small list;
+		for (int i = n; i-- > 0;)
+			list.push_front(i);
+
+		// Punch holes so chunks are partly filled
+		for (int k = 0; k < n / 4 && model.size() > 2; ++k) {
+			size_t at = rng() % (model.size() - 1);
+			list.erase_after(std::next(list.cbegin(), static_cast<std::ptrdiff_t>(at)));
+			model.erase(model.begin() + static_cast<std::ptrdiff_t>(at) + 1);
+		}
+
+		size_t size = model.size();
+		if (rng() % 2) {
+			// One element: the one after `it` goes after `pos`
+			size_t it = rng() % (size - 1);
+			size_t pos = rng() % size;
+			if (pos == it || pos == it + 1)
+				continue;
+			list.splice_after(std::next(list.cbegin(), static_cast<std::ptrdiff_t>(pos)), list,
+				std::next(list.cbegin(), static_cast<std::ptrdiff_t>(it)));
+			int moved = model[it + 1];
+			model.erase(model.begin() + static_cast<std::ptrdiff_t>(it) + 1);
+			size_t dest = pos > it ? pos - 1 : pos;
+			model.insert(model.begin() + static_cast<std::ptrdiff_t>(dest) + 1, moved);
+		}
+		else {
+			// The range (first, last), with pos outside it
+			size_t first = rng() % (size - 1);
+			size_t last = first + 1 + rng() % (size - first);
+			size_t pos = rng() % size;
+			if (pos > first && pos < last)
+				continue;
+			auto last_it = last == size ? list.cend() : std::next(list.cbegin(), static_cast<std::ptrdiff_t>(last));
+			list.splice_after(std::next(list.cbegin(), static_cast<std::ptrdiff_t>(pos)), list,
+				std::next(list.cbegin(), static_cast<std::ptrdiff_t>(first)), last_it);
+			std::vector<int> moved(model.begin() + static_cast<std::ptrdiff_t>(first) + 1, model.begin() + static_cast<std::ptrdiff_t>(last));
+			model.erase(model.begin() + static_cast<std::ptrdiff_t>(first) + 1, model.begin() + static_cast<std::ptrdiff_t>(last));
+			size_t dest = pos >= last ? pos - moved.size() : pos;
+			model.insert(model.begin() + static_cast<std::ptrdiff_t>(dest) + 1, moved.begin(), moved.end());
+		}
+
+		CHECK(values_of(list) == model);
+		CHECK(list.size() == model.size());
+	}
+}
+
+void test_resize() {
+	using Ints = Unrolled_forward_list<int>;
+	{
+		Ints list{ 1, 2, 3, 4, 5 };
+		list.resize(3);
+		CHECK(values_of(list) == std::vector<int>({ 1, 2, 3 }));
+		CHECK(list.size() == 3);
+	}
+	{
+		Ints list{ 1, 2, 3 };
+		list.resize(5, 9);
+		CHECK(values_of(list) == std::vector<int>({ 1, 2, 3, 9, 9 }));
+		CHECK(list.size() == 5);
+	}
+
+	// Across chunk boundaries, from and to empty
+	using Small = Unrolled_forward_list<int, std::allocator<int>, 4>;
+	for (int from = 0; from < 14; ++from) {
+		for (int to = 0; to < 14; ++to) {
+			Small list;
+			for (int i = from; i-- > 0;)
+				list.push_front(i);
+			list.resize(static_cast<size_t>(to), -1);
+
+			std::vector<int> expected;
+			for (int i = 0; i < to; ++i)
+				expected.push_back(i < from ? i : -1);
+			CHECK(values_of(list) == expected);
+			CHECK(list.size() == static_cast<size_t>(to));
+		}
+	}
+}
+
+int main() {
+	test_remove_if_throwing();
+	test_unique_throwing();
+	test_sort_throwing();
+	test_merge_throwing();
+	test_splice_same_list();
+	test_resize();
+	return Test::result();
+}
@@ -0,0 +1,80 @@
+// Work_stealing_deque: the owner pushes and pops while several thieves steal, starting from a tiny ring so it
+// grows under them, and every item comes out exactly once
+#include "../Stack/Work_stealing_deque.h"
+#include "Test.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+int main() {
+	{
+		Work_stealing_deque<int> d(2);
+		int out = -1;
+		CHECK(!d.try_pop(out));
+		CHECK(!d.try_steal(out));
+
+		for (int i = 0; i < 100; ++i)
+			d.push(i);
+		CHECK(d.size() == 100);
+		CHECK(d.capacity() >= 100);
+		CHECK(d.try_steal(out) && out == 0);
+		CHECK(d.try_pop(out) && out == 99);
+		for (int i = 98; i >= 1; --i)
+			CHECK(d.try_pop(out) && out == i);
+		CHECK(!d.try_pop(out));
+		CHECK(d.empty());
+	}
+
+	{
+		constexpr size_t n = 200'000;
+		constexpr int thieves = 3;
+
+		Work_stealing_deque<size_t> d(2);
+		std::unique_ptr<std::atomic<int>[]> seen(new std::atomic<int>[n]);
+		for (size_t i = 0; i < n; ++i)
+			seen[i].store(0, std::memory_order_relaxed);
+		std::atomic<bool> done{ false };
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < thieves; ++t)
+			threads.emplace_back([&] {
+				size_t item;
+				while (!done.load(std::memory_order_acquire)) {
+					if (d.try_steal(item))
+						seen[item].fetch_add(1, std::memory_order_relaxed);
+					else
+						std::this_thread::yield();
+				}
+			});
+
+		// Owner: bursts of pushes, each followed by popping part of it back
+		size_t item;
+		for (size_t next = 0; next < n;) {
+			size_t burst = next % 97 + 1;
+			for (size_t i = 0; i < burst && next < n; ++i)
+				d.push(next++);
+			for (size_t i = 0; i < burst / 3; ++i)
+				if (d.try_pop(item))
+					seen[item].fetch_add(1, std::memory_order_relaxed);
+		}
+		while (d.try_pop(item))
+			seen[item].fetch_add(1, std::memory_order_relaxed);
+
+		done.store(true, std::memory_order_release);
+		for (auto& t : threads)
+			t.join();
+
+		size_t once = 0;
+		for (size_t i = 0; i < n; ++i)
+			once += seen[i].load(std::memory_order_relaxed) == 1;
+		CHECK(once == n);
+		CHECK(d.empty());
+		CHECK(d.capacity() > 2);
+	}
+
+	return Test::result();
+}
@@ -0,0 +1,282 @@
+#ifndef _Fork_Join_Pool
+#define _Fork_Join_Pool
+
+#define ND [[nodiscard]]
+
+#include "../Queue/Queue.h"
+#include "../Stack/Work_stealing_deque.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+// Small work-stealing fork-join scheduler. Every worker owns a Work_stealing_deque of tasks: fork_join pushes
+// one branch onto the bottom of its own deque, runs the other inline, and then either pops its branch back
+// or, if a thief took it, keeps stealing until it is done. Idle workers steal from the top of random victims.
+// Work from outside the pool enters through run(), via a mutex-protected Queue that workers poll when they
+// have nothing else to do.
+class Fork_join_pool {
+public:
+	// threads == 0 picks std::thread::hardware_concurrency()
+	explicit Fork_join_pool(size_t threads = 0) {
+		if (threads == 0)
+			threads = std::thread::hardware_concurrency();
+		if (threads == 0)
+			threads = 1;
+
+		for (size_t i = 0; i < threads; ++i)
+			workers.emplace_back(new Worker(*this, static_cast<unsigned>(i) * 2654435761u + 1));
+		for (size_t i = 0; i < threads; ++i)
+			workers[i]->thread = std::thread([this, i] { work(*workers[i]); });
+	}
+
+	Fork_join_pool(const Fork_join_pool&) = delete;
+	Fork_join_pool& operator=(const Fork_join_pool&) = delete;
+
+	// Must not run while a run() call is still waiting
+	~Fork_join_pool() {
+		{
+			std::lock_guard<std::mutex> lock(m);
+			stopping.store(true, std::memory_order_relaxed);
+		}
+		wake.notify_all();
+
+		for (auto& w : workers)
+			w->thread.join();
+	}
+
+	ND size_t size() const noexcept { return workers.size(); }
+
+	// Runs f() on the pool and waits for its result; exceptions from f propagate to the caller.
+	// Called from inside a task it simply runs f() inline
+	template <typename F>
+	std::decay_t<std::invoke_result_t<F&>> run(F&& f) {
+		if (current_worker())
+			return f();
+
+		Root_task<std::remove_reference_t<F>> task(f);
+		{
+			std::lock_guard<std::mutex> lock(m);
+			injected.push(&task);
+		}
+		wake.notify_one();
+		return task.wait();
+	}
+
+	// Runs a() and b(), possibly in parallel, and returns once both are done. Must be called from a task running
+	// on this pool (anything reached from run()). If either throws, the first exception is rethrown after both finish
+	template <typename A, typename B>
+	void fork_join(A&& a, B&& b) {
+		Worker* self = current_worker();
+		if (!self) {
+			run([&] { fork_join(a, b); });
+			return;
+		}
+
+		Forked_task<std::remove_reference_t<B>> forked(b);
+		self->tasks.push(&forked);
+		if (sleepers.load(std::memory_order_relaxed))
+			wake.notify_one();
+
+		std::exception_ptr error;
+		try {
+			a();
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+
+		// Nested fork_joins inside a() have all joined, so b is on top of the deque unless it was stolen
+		Task* top;
+		if (self->tasks.try_pop(top))
+			top->execute();
+		else {
+			while (!forked.done.load(std::memory_order_acquire)) {
+				if (!try_run_stolen(*self))
+					std::this_thread::yield();
+			}
+		}
+
+		if (!error)
+			error = forked.error;
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+private:
+	struct Task {
+		virtual void execute() noexcept = 0;
+
+	protected:
+		~Task() = default;
+	};
+
+	template <typename F>
+	struct Forked_task final : Task {
+		F& f;
+		std::exception_ptr error;
+		std::atomic<bool> done{ false };
+
+		explicit Forked_task(F& f) : f(f) {}
+
+		void execute() noexcept override {
+			try {
+				f();
+			}
+			catch (...) {
+				error = std::current_exception();
+			}
+			done.store(true, std::memory_order_release);
+		}
+	};
+
+	// Lives on run()'s stack. done is set and signalled under m, so run() cannot return and destroy the task
+	// while execute() is still using it
+	template <typename F>
+	struct Root_task final : Task {
+		using Result = std::decay_t<std::invoke_result_t<F&>>;
+
+		F& f;
+		std::optional<std::conditional_t<std::is_void_v<Result>, bool, Result>> value;
+		std::exception_ptr error;
+		bool done = false;
+		std::mutex m;
+		std::condition_variable finished;
+
+		explicit Root_task(F& f) : f(f) {}
+
+		void execute() noexcept override {
+			try {
+				if constexpr (std::is_void_v<Result>)
+					f();
+				else
+					value.emplace(f());
+			}
+			catch (...) {
+				error = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(m);
+			done = true;
+			finished.notify_one();
+		}
+
+		Result wait() {
+			std::unique_lock<std::mutex> lock(m);
+			finished.wait(lock, [this] { return done; });
+			if (error)
+				std::rethrow_exception(error);
+			if constexpr (!std::is_void_v<Result>)
+				return std::move(*value);
+		}
+	};
+
+	struct Worker {
+		Fork_join_pool& pool;
+		Work_stealing_deque<Task*> tasks;
+		unsigned rng;
+		std::thread thread;
+
+		Worker(Fork_join_pool& pool, unsigned seed) : pool(pool), rng(seed) {}
+
+		// xorshift, for picking steal victims
+		unsigned next_random() noexcept {
+			rng ^= rng << 13;
+			rng ^= rng >> 17;
+			rng ^= rng << 5;
+			return rng;
+		}
+	};
+
+	// Failed attempts to find work before an idle worker goes to sleep
+	static constexpr int spins_before_sleep = 64;
+
+	static Worker*& current_worker_slot() noexcept {
+		static thread_local Worker* w = nullptr;
+		return w;
+	}
+
+	// The worker running on this thread, if it belongs to this pool
+	Worker* current_worker() const noexcept {
+		Worker* w = current_worker_slot();
+		return w && &w->pool == this ? w : nullptr;
+	}
+
+	// Steals one task from a random other worker and runs it
+	bool try_run_stolen(Worker& self) {
+		size_t n = workers.size();
+		if (n < 2)
+			return false;
+
+		size_t start = self.next_random() % n;
+		for (size_t i = 0; i < n; ++i) {
+			Worker& victim = *workers[(start + i) % n];
+			Task* task;
+			if (&victim != &self && victim.tasks.try_steal(task)) {
+				task->execute();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool try_run_injected() {
+		Task* task;
+		{
+			std::lock_guard<std::mutex> lock(m);
+			if (injected.empty())
+				return false;
+			task = injected.front();
+			injected.pop();
+		}
+		task->execute();
+		return true;
+	}
+
+	void work(Worker& self) {
+		current_worker_slot() = &self;
+
+		int idle = 0;
+		while (!stopping.load(std::memory_order_relaxed)) {
+			Task* task;
+			if (self.tasks.try_pop(task)) {
+				task->execute();
+				idle = 0;
+			}
+			else if (try_run_stolen(self) || try_run_injected())
+				idle = 0;
+			else if (++idle < spins_before_sleep)
+				std::this_thread::yield();
+			else {
+				// A fork only notifies when someone sleeps; the timeout covers a notify that raced with going to sleep
+				std::unique_lock<std::mutex> lock(m);
+				sleepers.fetch_add(1, std::memory_order_relaxed);
+				if (!stopping.load(std::memory_order_relaxed) && injected.empty())
+					wake.wait_for(lock, std::chrono::milliseconds(1));
+				sleepers.fetch_sub(1, std::memory_order_relaxed);
+				idle = 0;
+			}
+		}
+
+		current_worker_slot() = nullptr;
+	}
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	Queue<Task*> injected;
+	std::mutex m;
+	std::condition_variable wake;
+	std::atomic<int> sleepers{ 0 };
+	std::atomic<bool> stopping{ false };
+};
+
+
+#endif // !_Fork_Join_Pool
@@ -0,0 +1,91 @@
+#ifndef _Thread_Pool
+#define _Thread_Pool
+
+#define ND [[nodiscard]]
+
+#include "../Queue/Queue.h"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+// Fixed set of worker threads taking tasks from one shared FIFO.
+// submit() returns a std::future for the task's result; exceptions thrown by a task end up in its future.
+// The destructor runs every task already submitted, then joins the workers.
+class Thread_pool {
+public:
+	// threads == 0 picks std::thread::hardware_concurrency()
+	explicit Thread_pool(size_t threads = 0) {
+		if (threads == 0)
+			threads = std::thread::hardware_concurrency();
+		if (threads == 0)
+			threads = 1;
+
+		workers.reserve(threads);
+		for (size_t i = 0; i < threads; ++i)
+			workers.emplace_back([this] { work(); });
+	}
+
+	Thread_pool(const Thread_pool&) = delete;
+	Thread_pool& operator=(const Thread_pool&) = delete;
+
+	~Thread_pool() {
+		{
+			std::lock_guard<std::mutex> lock(m);
+			stopping = true;
+		}
+		ready.notify_all();
+
+		for (std::thread& w : workers)
+			w.join();
+	}
+
+	ND size_t size() const noexcept { return workers.size(); }
+
+	template <typename F>
+	ND std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& f) {
+		using Result = std::invoke_result_t<std::decay_t<F>>;
+
+		// std::function needs a copyable target, packaged_task is move-only
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+		std::future<Result> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(m);
+			tasks.push([task] { (*task)(); });
+		}
+		ready.notify_one();
+		return result;
+	}
+
+private:
+	void work() {
+		for (;;) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m);
+				ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+				if (tasks.empty())
+					return;
+
+				task = std::move(tasks.front());
+				tasks.pop();
+			}
+			task();
+		}
+	}
+
+	std::vector<std::thread> workers;
+	Queue<std::function<void()>> tasks;
+	std::mutex m;
+	std::condition_variable ready;
+	bool stopping = false;
+};
+
+
+#endif // !_Thread_Pool
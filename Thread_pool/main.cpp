@@ -0,0 +1,65 @@
+#include "Fork_join_pool.h"
+#include <iostream>
+#include <memory>
+
+using namespace std;
+
+// Fork-join on a Fork_join_pool: recursive Fibonacci and the sum of a binary tree, both splitting into
+// two branches with fork_join until the pieces are small enough to do serially.
+
+long long fib_serial(int n) {
+	return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+long long fib(Fork_join_pool& pool, int n) {
+	if (n < 20)
+		return fib_serial(n);
+
+	long long a, b;
+	pool.fork_join([&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+	return a + b;
+}
+
+struct Tree {
+	long long value;
+	unique_ptr<Tree> left, right;
+};
+
+unique_ptr<Tree> make_tree(int depth, long long& next) {
+	if (depth == 0)
+		return nullptr;
+
+	auto t = make_unique<Tree>();
+	t->value = next++;
+	t->left = make_tree(depth - 1, next);
+	t->right = make_tree(depth - 1, next);
+	return t;
+}
+
+long long tree_sum(Fork_join_pool& pool, const Tree* t, int depth) {
+	if (!t)
+		return 0;
+	if (depth < 10)
+		return t->value + tree_sum(pool, t->left.get(), depth - 1) + tree_sum(pool, t->right.get(), depth - 1);
+
+	long long l, r;
+	pool.fork_join([&] { l = tree_sum(pool, t->left.get(), depth - 1); },
+		[&] { r = tree_sum(pool, t->right.get(), depth - 1); });
+	return t->value + l + r;
+}
+
+int main() {
+	Fork_join_pool pool;
+	cout << pool.size() << " workers\n";
+
+	cout << "fib(32) = " << pool.run([&] { return fib(pool, 32); }) << '\n';
+
+	const int depth = 20;
+	long long next = 1;
+	auto tree = make_tree(depth, next);
+	long long nodes = next - 1;
+	cout << "sum of 1.." << nodes << " = " << pool.run([&] { return tree_sum(pool, tree.get(), depth); })
+		<< " (expected " << nodes * (nodes + 1) / 2 << ")\n";
+
+	return 0;
+}
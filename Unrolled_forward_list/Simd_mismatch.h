@@ -0,0 +1,165 @@
+#ifndef _Simd_Mismatch
+#define _Simd_Mismatch
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_MISMATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(SIMD_MISMATCH_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define SIMD_MISMATCH_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+
+// Finding the first difference between two arrays of arithmetic values, 16 (SSE2) or 32 (AVX2) bytes per step.
+// The widest instruction set the CPU supports is picked at the first call.
+
+enum class Simd_level {
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+// Element types whose equal object representations mean equivalent values, so they can be compared bytewise.
+// long double is left out, its padding bytes are unspecified
+template <typename T>
+constexpr bool simd_comparable = std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, long double>;
+
+namespace simd_detail {
+
+	using Mismatch_kernel = size_t (*)(const unsigned char*, const unsigned char*, size_t);
+
+	inline size_t mismatch_scalar(const unsigned char* a, const unsigned char* b, size_t n) {
+		size_t i = 0;
+		while (i < n && a[i] == b[i])
+			++i;
+		return i;
+	}
+
+	inline unsigned first_set_bit(unsigned mask) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+	}
+
+#ifdef SIMD_MISMATCH_SSE2
+	inline size_t mismatch_sse2(const unsigned char* a, const unsigned char* b, size_t n) {
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+			unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+			if (equal != 0xFFFFu)
+				return i + first_set_bit(~equal);
+		}
+		return i + mismatch_scalar(a + i, b + i, n - i);
+	}
+#endif
+
+#ifdef SIMD_MISMATCH_AVX2
+#ifdef __GNUC__
+	__attribute__((target("avx2")))
+#endif
+	inline size_t mismatch_avx2(const unsigned char* a, const unsigned char* b, size_t n) {
+		size_t i = 0;
+		for (; i + 32 <= n; i += 32) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+			unsigned equal = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+			if (equal != 0xFFFFFFFFu)
+				return i + first_set_bit(~equal);
+		}
+		return i + mismatch_sse2(a + i, b + i, n - i);
+	}
+
+	inline bool cpu_has_avx2() {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+		__cpuidex(info, 7, 0);
+		return os_saves_ymm && (info[1] & (1 << 5));
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	inline Simd_level detect() {
+#if defined(SIMD_MISMATCH_AVX2)
+		if (cpu_has_avx2())
+			return Simd_level::AVX2;
+#endif
+#if defined(SIMD_MISMATCH_SSE2)
+		return Simd_level::SSE2;
+#else
+		return Simd_level::Scalar;
+#endif
+	}
+
+	inline Mismatch_kernel kernel_for(Simd_level level) {
+		switch (level) {
+#ifdef SIMD_MISMATCH_AVX2
+		case Simd_level::AVX2: return mismatch_avx2;
+#endif
+#ifdef SIMD_MISMATCH_SSE2
+		case Simd_level::SSE2: return mismatch_sse2;
+#endif
+		default: return mismatch_scalar;
+		}
+	}
+
+}
+
+// Instruction set the comparisons run on
+inline Simd_level simd_level() {
+	static const Simd_level level = simd_detail::detect();
+	return level;
+}
+
+// Offset of the first byte where a and b differ, n if their first n bytes are equal
+inline size_t mismatch_bytes(const void* a, const void* b, size_t n) {
+	static const simd_detail::Mismatch_kernel kernel = simd_detail::kernel_for(simd_level());
+	return kernel(static_cast<const unsigned char*>(a), static_cast<const unsigned char*>(b), n);
+}
+
+// Index of the first i where a[i] < b[i] or b[i] < a[i], n if every pair is equivalent. Floating point pairs
+// that differ bitwise but are equivalent (+0.0 and -0.0, NaNs) are checked one by one and skipped
+template <typename T>
+size_t mismatch_elements(const T* a, const T* b, size_t n) {
+	static_assert(simd_comparable<T>, "mismatch_elements needs arithmetic elements");
+
+	size_t i = 0;
+	while (i < n) {
+		i += mismatch_bytes(a + i, b + i, (n - i) * sizeof(T)) / sizeof(T);
+		if (i == n)
+			break;
+
+		if constexpr (std::is_floating_point_v<T>) {
+			if (!(a[i] < b[i]) && !(b[i] < a[i])) {
+				++i;
+				continue;
+			}
+		}
+		return i;
+	}
+	return n;
+}
+
+
+#endif // !_Simd_Mismatch
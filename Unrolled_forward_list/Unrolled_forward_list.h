@@ -0,0 +1,1080 @@
+#ifndef _Unrolled_Forward_List
+#define _Unrolled_Forward_List
+
+#define ND [[nodiscard]]
+
+#include "../Forward_list/Forward_list.h"
+#include "Simd_mismatch.h"
+
+#include <memory>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <new>
+
+
+// Default number of elements per chunk: the chunk, header included, spans two cache lines
+template <typename T>
+constexpr size_t unrolled_chunk_size() {
+	constexpr size_t target = 128;
+	constexpr size_t header = 2 * sizeof(void*);
+	return sizeof(T) * 4 + header > target ? 4 : (target - header) / sizeof(T);
+}
+
+
+// Singly linked list that stores up to K elements per node in an inline array, so traversal is
+// mostly sequential memory access. The interface follows Forward_list. Unlike Forward_list, inserting or
+// erasing moves neighbouring elements of the same chunk, so those operations invalidate iterators into
+// that chunk past the affected position (insertion may also move the elements before it), and splicing
+// moves elements instead of relinking them, except for whole-list splice_after.
+template <typename T, typename Allocator = std::allocator<T>, size_t K = unrolled_chunk_size<T>()>
+class Unrolled_forward_list {
+	static_assert(K > 0 && K <= 0xFFFF, "chunk capacity must fit in unsigned short");
+
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using reference			= value_type&;
+	using const_reference	= const value_type&;
+	using allocator_type	= Allocator;
+	using difference_type	= std::ptrdiff_t;
+	using pointer			= typename std::allocator_traits<Allocator>::pointer;
+	using const_pointer		= typename std::allocator_traits<Allocator>::const_pointer;
+
+	static constexpr size_type chunk_capacity = K;
+
+
+private:
+	// Elements live in slots [first, last) of the storage, the rest is raw memory
+	struct Chunk {
+		Chunk* next = nullptr;
+		unsigned short first = 0;
+		unsigned short last = 0;
+		alignas(T) unsigned char storage[K * sizeof(T)];
+
+		Chunk(Chunk* next, unsigned short at) : next(next), first(at), last(at) {}
+
+		T* slot(size_t i) noexcept {
+			return std::launder(reinterpret_cast<T*>(storage + i * sizeof(T)));
+		}
+
+		const T* slot(size_t i) const noexcept {
+			return std::launder(reinterpret_cast<const T*>(storage + i * sizeof(T)));
+		}
+
+		size_t count() const noexcept { return last - first; }
+	};
+
+
+	template <bool IsConst>
+	struct common_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using difference_type = std::ptrdiff_t;
+		using value_type = T;
+		using pointer = std::conditional_t<IsConst, const T*, T*>;
+		using reference = std::conditional_t<IsConst, const T&, T&>;
+
+		friend class Unrolled_forward_list;
+
+	private:
+		std::conditional_t<IsConst, const Chunk*, Chunk*> chunk = nullptr;
+		size_t idx = 0;
+
+	public:
+		common_iterator(Chunk* chunk = nullptr, size_t idx = 0) : chunk(chunk), idx(idx) {}
+
+		template <bool IsOtherConst>
+		common_iterator(common_iterator<IsOtherConst> other) : chunk(other.chunk), idx(other.idx) {}
+
+		reference operator*() const {
+			return *chunk->slot(idx);
+		}
+
+		pointer operator->() const {
+			return chunk->slot(idx);
+		}
+
+		common_iterator& operator++() {
+			if (++idx == chunk->last) {
+				chunk = chunk->next;
+				idx = chunk ? chunk->first : 0;
+			}
+			return *this;
+		}
+
+		common_iterator operator++(int) {
+			common_iterator copy_iter(*this);
+			++(*this);
+			return copy_iter;
+		}
+
+		template <bool IsOtherConst>
+		bool operator!=(common_iterator<IsOtherConst> other) const {
+			return chunk != other.chunk || idx != other.idx;
+		}
+
+		template <bool IsOtherConst>
+		bool operator==(common_iterator<IsOtherConst> other) const {
+			return chunk == other.chunk && idx == other.idx;
+		}
+	};
+
+public:
+	using iterator			=	common_iterator<false>;
+	using const_iterator	=	common_iterator<true>;
+
+	ND iterator begin() noexcept {
+		return head ? iterator(head, head->first) : iterator();
+	}
+
+	ND iterator end() noexcept {
+		return iterator();
+	}
+
+	ND const_iterator begin() const noexcept {
+		return head ? const_iterator(head, head->first) : const_iterator();
+	}
+
+	ND const_iterator end() const noexcept {
+		return const_iterator();
+	}
+
+	ND const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	ND const_iterator cend() const noexcept {
+		return end();
+	}
+
+
+	Unrolled_forward_list() {}
+
+	explicit Unrolled_forward_list(const Allocator& alloc) : alloc(alloc) {}
+
+	Unrolled_forward_list(size_type count, const T& value, const Allocator& alloc = Allocator()) : alloc(alloc) {
+		Builder out(*this);
+		for (size_type i = 0; i < count; ++i)
+			out.emplace(value);
+		adopt(out);
+	}
+
+	template <typename U = T, std::enable_if_t<std::is_default_constructible_v<U>, int> = 0>
+	explicit Unrolled_forward_list(size_type count, const Allocator& alloc = Allocator()) : Unrolled_forward_list(count, T(), alloc) {}
+
+	template<class Iterator, typename std::enable_if_t<
+	std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category> &&
+	!std::is_integral_v<Iterator>, Iterator>* = nullptr>
+	Unrolled_forward_list(Iterator first, Iterator last, const Allocator& alloc = Allocator()) : alloc(alloc) {
+		Builder out(*this);
+		while (first != last)
+			out.emplace(*(first++));
+		adopt(out);
+	}
+
+	Unrolled_forward_list(const Unrolled_forward_list& other, const Allocator& alloc) : alloc(alloc) {
+		Builder out(*this);
+		for (const auto& x : other)
+			out.emplace(x);
+		adopt(out);
+	}
+
+	Unrolled_forward_list(const Unrolled_forward_list& other)
+		: Unrolled_forward_list(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())) {}
+
+	Unrolled_forward_list(Unrolled_forward_list&& other, const Allocator& alloc) : alloc(alloc) {
+		if (this->alloc == other.alloc) {
+			std::swap(head, other.head);
+			std::swap(sz, other.sz);
+		}
+		else {
+			Builder out(*this);
+			for (auto& x : other)
+				out.emplace(std::move(x));
+			adopt(out);
+			other.clear();
+		}
+	}
+
+	Unrolled_forward_list(Unrolled_forward_list&& other) noexcept : alloc(other.alloc) {
+		std::swap(head, other.head);
+		std::swap(sz, other.sz);
+	}
+
+	Unrolled_forward_list(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+		: Unrolled_forward_list(init.begin(), init.end(), alloc) {}
+
+	~Unrolled_forward_list() { clear(); }
+
+	Unrolled_forward_list& operator=(const Unrolled_forward_list& other) {
+		if (this == &other)
+			return *this;
+
+		if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
+			Unrolled_forward_list copied(other, other.get_allocator());
+			clear();
+			alloc = other.alloc;
+			std::swap(head, copied.head);
+			std::swap(sz, copied.sz);
+		}
+		else {
+			Unrolled_forward_list copied(other, get_allocator());
+			std::swap(head, copied.head);
+			std::swap(sz, copied.sz);
+		}
+
+		return *this;
+	}
+
+	Unrolled_forward_list& operator=(Unrolled_forward_list&& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value) {
+		if (this == &other)
+			return *this;
+
+		clear();
+		if (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value || alloc == other.alloc) {
+			if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value)
+				alloc = other.alloc;
+			std::swap(head, other.head);
+			std::swap(sz, other.sz);
+		}
+		else {
+			Unrolled_forward_list moved(std::move(other), get_allocator());
+			std::swap(head, moved.head);
+			std::swap(sz, moved.sz);
+		}
+		return *this;
+	}
+
+	Unrolled_forward_list& operator=(std::initializer_list<T> ilist) {
+		Unrolled_forward_list copied(ilist, get_allocator());
+		std::swap(head, copied.head);
+		std::swap(sz, copied.sz);
+
+		return *this;
+	}
+
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+
+
+	// Element access
+
+	ND reference front() noexcept { return *head->slot(head->first); }
+
+	ND const_reference front() const noexcept { return *head->slot(head->first); }
+
+
+	// Capacity
+
+	ND bool empty() const noexcept { return sz == 0; }
+
+	ND size_type size() const noexcept { return sz; }
+
+
+	// Modifiers
+
+	void clear() noexcept {
+		free_chain(head);
+		head = nullptr;
+		sz = 0;
+	}
+
+	void push_front(const T& val) {
+		emplace_front(val);
+	}
+
+	void push_front(T&& val) {
+		emplace_front(std::move(val));
+	}
+
+	void pop_front() {
+		erase_at(nullptr, head, head->first);
+	}
+
+	template <class... Args>
+	reference emplace_front(Args&&... args) {
+		if (!head || head->count() == K) {
+			// A fresh front chunk fills from its back, so repeated push_front never shifts
+			Chunk* c = new_chunk(head, K);
+			try {
+				construct(c, K - 1, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				delete_chunk(c);
+				throw;
+			}
+			c->first = K - 1;
+			head = c;
+			++sz;
+			return *c->slot(c->first);
+		}
+
+		return *insert_at(head, head->first, std::forward<Args>(args)...);
+	}
+
+	void swap(Unrolled_forward_list& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value) {
+		if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value)
+			std::swap(alloc, other.alloc);
+
+		std::swap(sz, other.sz);
+		std::swap(head, other.head);
+	}
+
+	iterator insert_after(const_iterator pos, const T& value) {
+		return emplace_after(pos, value);
+	}
+
+	iterator insert_after(const_iterator pos, T&& value) {
+		return emplace_after(pos, std::move(value));
+	}
+
+	iterator insert_after(const_iterator pos, size_type count, const T& value) {
+		iterator it(mut(pos.chunk), pos.idx);
+		for (size_type i = 0; i < count; ++i)
+			it = emplace_after(it, value);
+		return it;
+	}
+
+	template<class InputIt, typename std::enable_if<
+	std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value &&
+	!std::is_integral<InputIt>::value, InputIt>::type* = nullptr>
+	iterator insert_after(const_iterator pos, InputIt first, InputIt last) {
+		iterator it(mut(pos.chunk), pos.idx);
+		while (first != last)
+			it = emplace_after(it, *(first++));
+		return it;
+	}
+
+	iterator insert_after(const_iterator pos, std::initializer_list<T> ilist) {
+		return insert_after(pos, ilist.begin(), ilist.end());
+	}
+
+	template< class... Args >
+	iterator emplace_after(const_iterator pos, Args&&... args) {
+		Chunk* c = mut(pos.chunk);
+		size_t at = pos.idx + 1;
+
+		if (at < c->last) {
+			if (c->count() == K)
+				split(c, at);
+			else
+				return insert_at(c, at, std::forward<Args>(args)...);
+		}
+
+		if (c->last < K)
+			return insert_at(c, c->last, std::forward<Args>(args)...);
+
+		if (c->next && c->next->first > 0)
+			return insert_at(c->next, c->next->first, std::forward<Args>(args)...);
+
+		Chunk* n = new_chunk(c->next, 0);
+		c->next = n;
+		return insert_at(n, 0, std::forward<Args>(args)...);
+	}
+
+	iterator erase_after(const_iterator pos) {
+		Chunk* c = mut(pos.chunk);
+		if (pos.idx + 1 < c->last)
+			return erase_in_chunk(c, pos.idx + 1);
+		if (!c->next)
+			return end();
+		return erase_at(c, c->next, c->next->first);
+	}
+
+	iterator erase_after(const_iterator first, const_iterator last) {
+		if (first == last) return iterator(mut(last.chunk), last.idx);
+		size_type count = 0;
+		for (const_iterator it = std::next(first); it != last; ++it)
+			++count;
+
+		for (size_type i = 0; i < count; ++i)
+			erase_after(first);
+
+		iterator after(mut(first.chunk), first.idx);
+		return ++after;
+	}
+
+	template <typename U = T, std::enable_if_t<std::is_default_constructible<U>::value, int> = 0>
+	void resize(size_type count) {
+		resize(count, T());
+	}
+
+	// Like Forward_list::resize: keeps the first count elements, or appends copies of value at the back
+	void resize(size_type count, const T& value) {
+		if (count == 0) {
+			clear();
+			return;
+		}
+		if (sz == 0)
+			push_front(value);
+
+		Chunk* c = head;
+		size_type seen = c->count();
+		while (c->next && seen < count) {
+			c = c->next;
+			seen += c->count();
+		}
+
+		if (seen > count) {
+			size_t keep = c->last - (seen - count);
+			destroy_range(c, keep, c->last);
+			c->last = static_cast<unsigned short>(keep);
+		}
+		if (sz > count) {
+			free_chain(c->next);
+			c->next = nullptr;
+			sz = count;
+		}
+
+		iterator back(c, c->last - 1);
+		while (sz < count)
+			back = emplace_after(back, value);
+	}
+
+	// Operations
+	size_type remove(const T& val) {
+		return remove_if([&val](const T& x) { return x == val; });
+	}
+
+	// Survivors are packed into full chunks, so erase-heavy workloads do not leave sparse chunks behind.
+	// If p or a move throws, the elements already removed stay removed and the rest stay in order
+	template <typename UnaryPredicate>
+	size_type remove_if(UnaryPredicate p) {
+		size_type before = sz;
+		Builder out(*this);
+		Chunk* c = head;
+		size_t i = 0;
+		head = nullptr;
+
+		try {
+			while (c) {
+				prefetch(c->next);
+				for (i = c->first; i < c->last; ++i) {
+					if (!p(*c->slot(i)))
+						out.emplace(std::move(*c->slot(i)));
+				}
+				c = out.recycle(c);
+			}
+		}
+		catch (...) {
+			recover(out, c, i);
+			throw;
+		}
+
+		adopt(out);
+		return before - sz;
+	}
+
+	void reverse() noexcept {
+		Chunk* left = nullptr;
+		Chunk* right = head;
+
+		while (right) {
+			std::reverse(right->slot(right->first), right->slot(right->last));
+			Chunk* next_to_right = right->next;
+			right->next = left;
+			left = right;
+			right = next_to_right;
+		}
+
+		head = left;
+	}
+
+	template< class BinaryPredicate = std::equal_to<T>>
+	size_type unique(BinaryPredicate equal = BinaryPredicate()) {
+		if (sz <= 1)
+			return 0;
+
+		size_type before = sz;
+		Builder out(*this);
+		Chunk* c = head;
+		size_t i = 0;
+		head = nullptr;
+
+		try {
+			while (c) {
+				prefetch(c->next);
+				for (i = c->first; i < c->last; ++i) {
+					if (!out.last || !equal(*out.last->slot(out.last->last - 1), *c->slot(i)))
+						out.emplace(std::move(*c->slot(i)));
+				}
+				c = out.recycle(c);
+			}
+		}
+		catch (...) {
+			recover(out, c, i);
+			throw;
+		}
+
+		adopt(out);
+		return before - sz;
+	}
+
+	// Whole-list splice relinks chunks; only the chunk holding pos is split
+	void splice_after(const_iterator pos, Unrolled_forward_list& other) {
+		if (other.empty() || this == &other) return;
+
+		Chunk* c = mut(pos.chunk);
+		if (pos.idx + 1 < c->last)
+			split(c, pos.idx + 1);
+
+		Chunk* other_last = other.head;
+		while (other_last->next)
+			other_last = other_last->next;
+
+		other_last->next = c->next;
+		c->next = other.head;
+		sz += other.sz;
+
+		other.head = nullptr;
+		other.sz = 0;
+	}
+
+	// other may be this list: pos is then located again after the erase, which can move the elements around it
+	void splice_after(const_iterator pos, Unrolled_forward_list& other, const_iterator it) {
+		const_iterator next_to_it = std::next(it);
+		if (pos == it || pos == next_to_it) return;
+
+		T moved(std::move(*iterator(mut(next_to_it.chunk), next_to_it.idx)));
+		pos = other.erase_after_tracking(it, pos);
+		emplace_after(pos, std::move(moved));
+	}
+
+	// The elements are first moved out of other into a chain of their own, so that when other is this list
+	// erasing them and inserting them never shift each other's positions
+	void splice_after(const_iterator pos, Unrolled_forward_list& other, const_iterator first, const_iterator last) {
+		size_type count = 0;
+		for (const_iterator it = std::next(first); it != last; ++it)
+			++count;
+		if (count == 0) return;
+
+		Unrolled_forward_list moved(get_allocator());
+		Builder out(moved);
+		for (size_type i = 0; i < count; ++i) {
+			const_iterator victim = std::next(first);
+			out.emplace(std::move(*iterator(mut(victim.chunk), victim.idx)));
+			pos = other.erase_after_tracking(first, pos);
+		}
+
+		moved.adopt(out);
+		insert_after(pos, std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()));
+	}
+
+	// If comp or a move throws, every element of both lists ends up in this one, in unspecified order
+	template <typename Compare = std::less<T>>
+	void merge(Unrolled_forward_list& other, Compare comp = Compare()) {
+		if (this == &other || !other.head) return;
+
+		size_type total = sz + other.sz;
+		Chunk* a = head;
+		Chunk* b = other.head;
+		head = other.head = nullptr;
+		sz = other.sz = 0;
+
+		try {
+			head = merge_chains(a, b, comp);
+		}
+		catch (...) {
+			head = a;
+			sz = total;
+			throw;
+		}
+		sz = total;
+	}
+
+	// Each chunk is insertion-sorted in place, then chunk runs are merged bottom-up like Forward_list::sort.
+	// Merging moves elements into recycled chunks, so apart from a spare chunk or two nothing is allocated.
+	// If comp or a move throws, every element stays in the list, in unspecified order
+	template <typename Compare = std::less<T>>
+	void sort(Compare comp = Compare()) {
+		Chunk* bins[64] = {};
+		size_t used = 0;
+		Chunk* c = head;
+		Chunk* carry = nullptr;
+		Chunk* result = nullptr;
+		head = nullptr;
+
+		try {
+			while (c) {
+				carry = c;
+				c = c->next;
+				carry->next = nullptr;
+				sort_chunk(carry, comp);
+
+				size_t i = 0;
+				for (; i < used && bins[i]; ++i) {
+					carry = merge_chains(bins[i], carry, comp);
+					bins[i] = nullptr;
+				}
+
+				bins[i] = carry;
+				carry = nullptr;
+				if (i == used)
+					++used;
+			}
+
+			for (size_t i = 0; i < used; ++i) {
+				result = merge_chains(bins[i], result, comp);
+				bins[i] = nullptr;
+			}
+		}
+		catch (...) {
+			// Each element is in exactly one of the bins, carry, result or the chunks not reached yet
+			Chunk* all = concat(result, c);
+			all = concat(carry, all);
+			for (size_t i = used; i-- > 0;)
+				all = concat(bins[i], all);
+			head = all;
+			throw;
+		}
+
+		head = result;
+	}
+
+	// Contiguous runs of elements, one per chunk, in list order. f(const T* first, size_t count)
+	template <typename F>
+	void for_each_run(F f) const {
+		for (const Chunk* c = head; c; c = c->next)
+			f(c->slot(c->first), c->count());
+	}
+
+private:
+	template <typename U, typename A, size_t N>
+	friend ListCompareResult compare_lists(const Unrolled_forward_list<U, A, N>& lhs, const Unrolled_forward_list<U, A, N>& rhs);
+
+	using NodeAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+
+	// Lexicographic comparison of arithmetic elements. The two chunk chains are walked side by side and each
+	// stretch where both sides are contiguous goes through mismatch_elements in one call
+	ListCompareResult compare_runs(const Unrolled_forward_list& rhs) const {
+		const Chunk* lc = head;
+		const Chunk* rc = rhs.head;
+		size_t li = lc ? lc->first : 0;
+		size_t ri = rc ? rc->first : 0;
+
+		while (lc && rc) {
+			size_t n = std::min<size_t>(lc->last - li, rc->last - ri);
+			const T* a = lc->slot(li);
+			const T* b = rc->slot(ri);
+
+			size_t at = mismatch_elements(a, b, n);
+			if (at < n)
+				return a[at] < b[at] ? ListCompareResult::Less : ListCompareResult::Greater;
+
+			li += n;
+			ri += n;
+			if (li == lc->last) {
+				lc = lc->next;
+				li = lc ? lc->first : 0;
+			}
+			if (ri == rc->last) {
+				rc = rc->next;
+				ri = rc ? rc->first : 0;
+			}
+		}
+
+		if (!lc && !rc) return ListCompareResult::Equal;
+		if (!lc) return ListCompareResult::Less;
+		return ListCompareResult::Greater;
+	}
+
+
+	// Appends elements to a fresh chain, reusing chunks that were already drained before allocating new ones
+	struct Builder {
+		Unrolled_forward_list& list;
+		Chunk* first = nullptr;
+		Chunk* last = nullptr;
+		Chunk* spare = nullptr;
+		size_type count = 0;
+
+		explicit Builder(Unrolled_forward_list& list) : list(list) {}
+
+		Builder(const Builder&) = delete;
+		Builder& operator=(const Builder&) = delete;
+
+		~Builder() {
+			list.free_chain(first);
+			list.free_chain(spare);
+		}
+
+		template <class... Args>
+		void emplace(Args&&... args) {
+			if (!last || last->last == K) {
+				Chunk* c = spare;
+				if (c) {
+					spare = c->next;
+					c->next = nullptr;
+				}
+				else {
+					c = list.new_chunk(nullptr, 0);
+				}
+
+				if (last)
+					last->next = c;
+				else
+					first = c;
+				last = c;
+			}
+
+			list.construct(last, last->last, std::forward<Args>(args)...);
+			++last->last;
+			++count;
+		}
+
+		// Destroys what is left in a drained source chunk and keeps it for reuse. Returns the next source chunk
+		Chunk* recycle(Chunk* c) noexcept {
+			Chunk* next = c->next;
+			list.destroy_range(c, c->first, c->last);
+			c->first = c->last = 0;
+			c->next = spare;
+			spare = c;
+			return next;
+		}
+
+		Chunk* release() noexcept {
+			Chunk* chain = first;
+			first = last = nullptr;
+			count = 0;
+			return chain;
+		}
+
+		// For a pass that threw: drops the already consumed slots [c->first, at) of source chunk c, recycling c
+		// if nothing is left in it. Returns the source chain from the first element not consumed yet
+		Chunk* unconsumed(Chunk* c, size_t at) noexcept {
+			if (!c) return nullptr;
+			list.destroy_range(c, c->first, at);
+			c->first = static_cast<unsigned short>(at);
+			return c->first == c->last ? recycle(c) : c;
+		}
+
+		// The chain built so far followed by rest
+		Chunk* release_with(Chunk* rest) noexcept {
+			if (!last) return rest;
+			last->next = rest;
+			return release();
+		}
+	};
+
+
+	static void prefetch(const Chunk* c) noexcept {
+#if defined(__GNUC__)
+		if (c) __builtin_prefetch(c);
+#else
+		(void)c;
+#endif
+	}
+
+	static Chunk* mut(const Chunk* c) noexcept {
+		return const_cast<Chunk*>(c);
+	}
+
+	Chunk* new_chunk(Chunk* next, unsigned short at) {
+		Chunk* c = std::allocator_traits<NodeAlloc>::allocate(alloc, 1);
+		::new (static_cast<void*>(c)) Chunk(next, at);
+		return c;
+	}
+
+	void delete_chunk(Chunk* c) noexcept {
+		std::allocator_traits<NodeAlloc>::deallocate(alloc, c, 1);
+	}
+
+	template <class... Args>
+	void construct(Chunk* c, size_t i, Args&&... args) {
+		std::allocator_traits<NodeAlloc>::construct(alloc, c->slot(i), std::forward<Args>(args)...);
+	}
+
+	void destroy_range(Chunk* c, size_t from, size_t to) noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (size_t i = from; i < to; ++i)
+				std::allocator_traits<NodeAlloc>::destroy(alloc, c->slot(i));
+		}
+	}
+
+	void free_chain_node(Chunk* c) noexcept {
+		destroy_range(c, c->first, c->last);
+		delete_chunk(c);
+	}
+
+	void free_chain(Chunk* c) noexcept {
+		while (c) {
+			Chunk* next = c->next;
+			free_chain_node(c);
+			c = next;
+		}
+	}
+
+	void adopt(Builder& out) noexcept {
+		free_chain(head);
+		sz = out.count;
+		head = out.release();
+	}
+
+	// After a single-pass rebuild threw at slot `at` of source chunk c: the list becomes what out built followed
+	// by the source elements not reached yet, so nothing is leaked and sz matches again
+	void recover(Builder& out, Chunk* c, size_t at) noexcept {
+		Chunk* rest = out.unconsumed(c, at);
+		size_type n = out.count;
+		for (Chunk* r = rest; r; r = r->next)
+			n += r->count();
+		head = out.release_with(rest);
+		sz = n;
+	}
+
+	// Links chain b after the last chunk of chain a
+	static Chunk* concat(Chunk* a, Chunk* b) noexcept {
+		if (!a) return b;
+		Chunk* last = a;
+		while (last->next)
+			last = last->next;
+		last->next = b;
+		return a;
+	}
+
+	// Moves slots [at, last) of a full chunk into a new chunk linked right after it
+	void split(Chunk* c, size_t at) {
+		Chunk* n = new_chunk(c->next, 0);
+		for (size_t i = at; i < c->last; ++i) {
+			construct(n, n->last, std::move(*c->slot(i)));
+			++n->last;
+		}
+
+		destroy_range(c, at, c->last);
+		c->last = static_cast<unsigned short>(at);
+		c->next = n;
+	}
+
+	// Inserts before slot `at` (first <= at <= last) of a chunk that still has a free slot
+	template <class... Args>
+	iterator insert_at(Chunk* c, size_t at, Args&&... args) {
+		if (at == c->last && c->last < K) {
+			construct(c, at, std::forward<Args>(args)...);
+			++c->last;
+			++sz;
+			return iterator(c, at);
+		}
+
+		if (at == c->first && c->first > 0) {
+			construct(c, at - 1, std::forward<Args>(args)...);
+			--c->first;
+			++sz;
+			return iterator(c, at - 1);
+		}
+
+		T value(std::forward<Args>(args)...);
+		if (c->last < K) {
+			construct(c, c->last, std::move(*c->slot(c->last - 1)));
+			std::move_backward(c->slot(at), c->slot(c->last - 1), c->slot(c->last));
+			++c->last;
+		}
+		else {
+			construct(c, c->first - 1, std::move(*c->slot(c->first)));
+			std::move(c->slot(c->first + 1), c->slot(at), c->slot(c->first));
+			--c->first;
+			--at;
+		}
+
+		*c->slot(at) = std::move(value);
+		++sz;
+		return iterator(c, at);
+	}
+
+	// Erases slot `at` of chunk c, which must keep at least one element. Only the elements after `at` move,
+	// so iterators to earlier elements stay valid. When c and its successor together fit into half a chunk,
+	// the successor's elements are appended to c, so erase-heavy workloads do not leave near-empty chunks behind
+	iterator erase_in_chunk(Chunk* c, size_t at) {
+		size_t next_at = at;
+		if (at == c->first) {
+			destroy_range(c, at, at + 1);
+			++c->first;
+			++next_at;
+		}
+		else {
+			std::move(c->slot(at + 1), c->slot(c->last), c->slot(at));
+			destroy_range(c, c->last - 1, c->last);
+			--c->last;
+		}
+		--sz;
+
+		Chunk* n = c->next;
+		if (n && c->count() + n->count() <= K / 2 && c->last + n->count() <= K) {
+			for (size_t i = n->first; i < n->last; ++i) {
+				construct(c, c->last, std::move(*n->slot(i)));
+				++c->last;
+			}
+
+			c->next = n->next;
+			free_chain_node(n);
+		}
+
+		if (next_at == c->last)
+			return c->next ? iterator(c->next, c->next->first) : end();
+		return iterator(c, next_at);
+	}
+
+	// Erases slot `at` of chunk c, unlinking and freeing c if it becomes empty. prev is c's predecessor or nullptr for head
+	iterator erase_at(Chunk* prev, Chunk* c, size_t at) {
+		if (c->count() > 1)
+			return erase_in_chunk(c, at);
+
+		Chunk* next = c->next;
+		if (prev)
+			prev->next = next;
+		else
+			head = next;
+		free_chain_node(c);
+		--sz;
+		return next ? iterator(next, next->first) : end();
+	}
+
+	// erase_after(it) that also returns where pos, an iterator into this list, points afterwards: erasing moves
+	// the later elements of the erased one's chunk down a slot and may pull the next chunk's elements into it.
+	// pos must not be the erased element
+	const_iterator erase_after_tracking(const_iterator it, const_iterator pos) {
+		const_iterator victim = std::next(it);
+		Chunk* c = mut(victim.chunk);
+		Chunk* n = c->next;
+		size_t erased = victim.idx - c->first;
+		size_t offset = pos.idx - (pos.chunk ? pos.chunk->first : 0);
+		size_t n_count = n ? n->count() : 0;
+		bool frees_c = c->count() == 1;
+
+		erase_after(it);
+
+		if (pos.chunk == c)
+			return const_iterator(c, c->first + (offset > erased ? offset - 1 : offset));
+		if (pos.chunk == n && !frees_c && c->next != n)
+			return const_iterator(c, c->last - n_count + offset);
+		return pos;
+	}
+
+	template <typename Compare>
+	static void sort_chunk(Chunk* c, Compare& comp) {
+		for (size_t i = c->first + 1; i < c->last; ++i) {
+			if (!comp(*c->slot(i), *c->slot(i - 1)))
+				continue;
+
+			// Slot j is the hole left by the shifts, value goes back there if comp throws
+			T value(std::move(*c->slot(i)));
+			size_t j = i;
+			try {
+				for (; j > c->first && comp(value, *c->slot(j - 1)); --j)
+					*c->slot(j) = std::move(*c->slot(j - 1));
+			}
+			catch (...) {
+				*c->slot(j) = std::move(value);
+				throw;
+			}
+			*c->slot(j) = std::move(value);
+		}
+	}
+
+	// Stable merge of two sorted chains into a new chain. Drained source chunks are recycled for the output.
+	// If comp or a move throws, a is left holding every element of both chains, in unspecified order, and b none
+	template <typename Compare>
+	Chunk* merge_chains(Chunk*& a_chain, Chunk*& b_chain, Compare& comp) {
+		Chunk* a = a_chain;
+		Chunk* b = b_chain;
+		if (!a) return b;
+		if (!b) return a;
+
+		Builder out(*this);
+		size_t i = a->first, j = b->first;
+
+		try {
+			while (a && b) {
+				if (comp(*b->slot(j), *a->slot(i))) {
+					out.emplace(std::move(*b->slot(j)));
+					if (++j == b->last) {
+						b = out.recycle(b);
+						j = b ? b->first : 0;
+					}
+				}
+				else {
+					out.emplace(std::move(*a->slot(i)));
+					if (++i == a->last) {
+						a = out.recycle(a);
+						i = a ? a->first : 0;
+					}
+				}
+			}
+		}
+		catch (...) {
+			Chunk* rest = concat(out.unconsumed(a, i), out.unconsumed(b, j));
+			a_chain = out.release_with(rest);
+			b_chain = nullptr;
+			throw;
+		}
+
+		// The rest of the remaining chain is linked as is, its already moved-from prefix is dropped
+		Chunk* rest = a ? a : b;
+		size_t k = a ? i : j;
+		destroy_range(rest, rest->first, k);
+		rest->first = static_cast<unsigned short>(k);
+		out.last->next = rest;
+
+		return out.release();
+	}
+
+	NodeAlloc alloc;
+	Chunk* head = nullptr;
+	size_t sz = 0;
+};
+
+
+template<typename T, typename Allocator, size_t K>
+ListCompareResult compare_lists(const Unrolled_forward_list<T, Allocator, K>& lhs, const Unrolled_forward_list<T, Allocator, K>& rhs) {
+	if constexpr (simd_comparable<T>)
+		return lhs.compare_runs(rhs);
+
+	auto lit = lhs.begin(), rit = rhs.begin();
+	while (lit != lhs.end() && rit != rhs.end()) {
+		if (*lit < *rit) return ListCompareResult::Less;
+		if (*rit < *lit) return ListCompareResult::Greater;
+		++lit;
+		++rit;
+	}
+	if (lit == lhs.end() && rit == rhs.end()) return ListCompareResult::Equal;
+	if (lit == lhs.end()) return ListCompareResult::Less;
+	return ListCompareResult::Greater;
+}
+
+template<typename T, typename Allocator, size_t K>
+bool operator==(const Unrolled_forward_list<T, Allocator, K>& lhs, const Unrolled_forward_list<T, Allocator, K>& rhs) {
+	return lhs.size() == rhs.size() && compare_lists(lhs, rhs) == ListCompareResult::Equal;
+}
+
+template<typename T, typename Allocator, size_t K>
+bool operator!=(const Unrolled_forward_list<T, Allocator, K>& lhs, const Unrolled_forward_list<T, Allocator, K>& rhs) {
+	return !(lhs == rhs);
+}
+
+template<typename T, typename Allocator, size_t K>
+bool operator<(const Unrolled_forward_list<T, Allocator, K>& lhs, const Unrolled_forward_list<T, Allocator, K>& rhs) {
+	return compare_lists(lhs, rhs) == ListCompareResult::Less;
+}
+
+template<typename T, typename Allocator, size_t K>
+bool operator<=(const Unrolled_forward_list<T, Allocator, K>& lhs, const Unrolled_forward_list<T, Allocator, K>& rhs) {
+	return compare_lists(lhs, rhs) != ListCompareResult::Greater;
+}
+
+template<typename T, typename Allocator, size_t K>
+bool operator>(const Unrolled_forward_list<T, Allocator, K>& lhs, const Unrolled_forward_list<T, Allocator, K>& rhs) {
+	return compare_lists(lhs, rhs) == ListCompareResult::Greater;
+}
+
+template<typename T, typename Allocator, size_t K>
+bool operator>=(const Unrolled_forward_list<T, Allocator, K>& lhs, const Unrolled_forward_list<T, Allocator, K>& rhs) {
+	return compare_lists(lhs, rhs) != ListCompareResult::Less;
+}
+
+namespace std
+{
+	template <typename T, typename Allocator, size_t K>
+	void swap(Unrolled_forward_list<T, Allocator, K>& l, Unrolled_forward_list<T, Allocator, K>& r) {
+		l.swap(r);
+	}
+}
+
+#endif // !_Unrolled_Forward_List